@@ -2,7 +2,9 @@
 #define CP_ALL_HPP
 
 #include "base.hpp"
+#include "io.hpp"
 #include "math.hpp"
+#include "poly.hpp"
 #include "ds.hpp"
 #include "graph.hpp"
 #include "strings.hpp"
@@ -3,11 +3,14 @@
 
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <bitset>
 #include <chrono>
 #include <climits>
 #include <cmath>
 #include <cstdint>
+#include <cstdio>
+#include <cstring>
 #include <deque>
 #include <functional>
 #include <iomanip>
@@ -20,8 +23,12 @@
 #include <random>
 #include <set>
 #include <stack>
+#include <stdexcept>
 #include <string>
+#include <string_view>
+#include <thread>
 #include <tuple>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 #include <utility>
@@ -54,4 +61,23 @@ struct RNG {
     double next_double() { return uniform_real_distribution<double>(0.0, 1.0)(rng); }
 };
 
+inline int thread_count(int threads) {
+    return threads > 0 ? threads : max(1, (int)thread::hardware_concurrency());
+}
+
+template <class T>
+bool atomic_relax_min(atomic<T>& a, T v) {
+    T cur = a.load(memory_order_relaxed);
+    while (v < cur) if (a.compare_exchange_weak(cur, v, memory_order_relaxed)) return true;
+    return false;
+}
+
+template <class F>
+void parallel_for(ll n, int threads, F f) {
+    vector<thread> pool;
+    for (int t = 1; t < threads; t++) pool.emplace_back(f, n * t / threads, n * (t + 1) / threads, t);
+    f(0LL, n / threads, 0);
+    for (auto& th : pool) th.join();
+}
+
 #endif
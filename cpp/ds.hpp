@@ -98,81 +98,332 @@ struct RollbackDSU {
     }
 };
 
-template <class T, class F>
+struct ParityRollbackDSU {
+    vector<int> p, sz, par;
+    vector<pair<int,int>> st;
+    int comps, odd = 0;
+    ParityRollbackDSU(int n) : p(n), sz(n, 1), par(n, 0), comps(n) { iota(ALL(p), 0); }
+    pair<int,int> find_parity(int x) {
+        int c = 0;
+        while (x != p[x]) { c ^= par[x]; x = p[x]; }
+        return {x, c};
+    }
+    int find(int x) { return find_parity(x).first; }
+    bool bipartite() const { return odd == 0; }
+    int snapshot() const { return SZ(st); }
+    void rollback(int t) {
+        while (SZ(st) > t) {
+            auto [b, a] = st.back(); st.pop_back();
+            if (b == -1) { odd -= a; continue; }
+            p[b] = b;
+            par[b] = 0;
+            sz[a] -= sz[b];
+            comps++;
+        }
+    }
+    bool unite(int a, int b) {
+        auto [ra, pa] = find_parity(a);
+        auto [rb, pb] = find_parity(b);
+        if (ra == rb) {
+            int bad = pa == pb;
+            odd += bad;
+            st.push_back({-1, bad});
+            return false;
+        }
+        if (sz[ra] < sz[rb]) swap(ra, rb);
+        st.push_back({rb, ra});
+        p[rb] = ra;
+        par[rb] = pa ^ pb ^ 1;
+        sz[ra] += sz[rb];
+        comps--;
+        return true;
+    }
+};
+
+struct ConcurrentDSU {
+    int n;
+    unique_ptr<atomic<int>[]> p;
+    ConcurrentDSU(int n = 0) : n(n), p(new atomic<int>[n]) {
+        REP(i, n) p[i].store(i, memory_order_relaxed);
+    }
+    int find(int x) {
+        while (true) {
+            int px = p[x].load(memory_order_acquire);
+            if (px == x) return x;
+            int gx = p[px].load(memory_order_acquire);
+            if (gx != px) p[x].compare_exchange_weak(px, gx, memory_order_acq_rel);
+            x = gx;
+        }
+    }
+    bool same(int a, int b) {
+        while (true) {
+            a = find(a); b = find(b);
+            if (a == b) return true;
+            if (p[a].load(memory_order_acquire) == a) return false;
+        }
+    }
+    bool unite(int a, int b) {
+        while (true) {
+            a = find(a); b = find(b);
+            if (a == b) return false;
+            if (a < b) swap(a, b);
+            int expected = a;
+            if (p[a].compare_exchange_strong(expected, b, memory_order_acq_rel)) return true;
+        }
+    }
+};
+
+template <class T>
+struct SumMonoid {
+    using S = T;
+    static S op(const S& a, const S& b) { return a + b; }
+    static S id() { return S(); }
+};
+
+template <class T>
+struct MinMonoid {
+    using S = T;
+    static S op(const S& a, const S& b) { return min(a, b); }
+    static S id() { return numeric_limits<T>::max(); }
+};
+
+template <class T>
+struct MaxMonoid {
+    using S = T;
+    static S op(const S& a, const S& b) { return max(a, b); }
+    static S id() { return numeric_limits<T>::lowest(); }
+};
+
+template <class M>
 struct SegmentTree {
+    using S = typename M::S;
     int n;
-    F merge;
-    T neutral;
-    unique_ptr<T[]> st;
-    SegmentTree(int n, F merge, T neutral) : n(n), merge(merge), neutral(neutral), st(new T[4 * n]) {}
-    void build(const vector<T>& v, int p, int l, int r) {
-        if (l == r) { st[p] = v[l]; return; }
-        int m = (l + r) >> 1;
-        build(v, p << 1, l, m);
-        build(v, p << 1 | 1, m + 1, r);
-        st[p] = merge(st[p << 1], st[p << 1 | 1]);
-    }
-    T query(int p, int l, int r, int ql, int qr) const {
-        if (qr < l || r < ql) return neutral;
-        if (ql <= l && r <= qr) return st[p];
-        int m = (l + r) >> 1;
-        return merge(query(p << 1, l, m, ql, qr), query(p << 1 | 1, m + 1, r, ql, qr));
-    }
-    void update(int p, int l, int r, int idx, T val) {
-        if (l == r) { st[p] = val; return; }
-        int m = (l + r) >> 1;
-        if (idx <= m) update(p << 1, l, m, idx, val);
-        else update(p << 1 | 1, m + 1, r, idx, val);
-        st[p] = merge(st[p << 1], st[p << 1 | 1]);
+    vector<S> t;
+    SegmentTree(int n = 0) : n(n), t(2 * n, M::id()) {}
+    SegmentTree(const vector<S>& v) : n(SZ(v)), t(2 * n) { build(v); }
+    void build(const vector<S>& v) {
+        copy(ALL(v), t.begin() + n);
+        for (int i = n - 1; i > 0; i--) t[i] = M::op(t[i << 1], t[i << 1 | 1]);
+    }
+    S get(int idx) const { return t[idx + n]; }
+    void update(int idx, S val) {
+        for (t[idx += n] = val; idx >>= 1;) t[idx] = M::op(t[idx << 1], t[idx << 1 | 1]);
+    }
+    S query(int l, int r) const {
+        S resl = M::id(), resr = M::id();
+        for (l += n, r += n + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) resl = M::op(resl, t[l++]);
+            if (r & 1) resr = M::op(t[--r], resr);
+        }
+        return M::op(resl, resr);
+    }
+    S all() const { return query(0, n - 1); }
+    int cover(int l, int r, int* nodes) const {
+        int nl = 0, nr = 0, rt[32];
+        for (l += n, r += n + 1; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) nodes[nl++] = l++;
+            if (r & 1) rt[nr++] = --r;
+        }
+        while (nr) nodes[nl++] = rt[--nr];
+        return nl;
+    }
+    template <class P>
+    int max_right(int l, P pred) const {
+        int nodes[64], k = cover(l, n - 1, nodes);
+        S acc = M::id();
+        REP(i, k) {
+            int v = nodes[i];
+            S nxt = M::op(acc, t[v]);
+            if (pred(nxt)) { acc = nxt; continue; }
+            while (v < n) {
+                v <<= 1;
+                nxt = M::op(acc, t[v]);
+                if (pred(nxt)) { acc = nxt; v++; }
+            }
+            return v - n - 1;
+        }
+        return n - 1;
+    }
+    template <class P>
+    int min_left(int r, P pred) const {
+        int nodes[64], k = cover(0, r, nodes);
+        S acc = M::id();
+        for (int i = k - 1; i >= 0; i--) {
+            int v = nodes[i];
+            S nxt = M::op(t[v], acc);
+            if (pred(nxt)) { acc = nxt; continue; }
+            while (v < n) {
+                v = v << 1 | 1;
+                nxt = M::op(t[v], acc);
+                if (pred(nxt)) { acc = nxt; v--; }
+            }
+            return v - n + 1;
+        }
+        return 0;
     }
 };
 
-template <class T, class F>
+struct AddSumLazy {
+    struct S { ll sum; int len; };
+    using F = ll;
+    static S make(ll v) { return {v, 1}; }
+    static S op(const S& a, const S& b) { return {a.sum + b.sum, a.len + b.len}; }
+    static S e() { return {0, 0}; }
+    static S mapping(const F& f, const S& x) { return {x.sum + f * x.len, x.len}; }
+    static F composition(const F& f, const F& g) { return f + g; }
+    static F id() { return 0; }
+};
+
+struct AssignSumLazy {
+    struct S { ll sum; int len; };
+    using F = ll;
+    static constexpr F NONE = LLONG_MIN;
+    static S make(ll v) { return {v, 1}; }
+    static S op(const S& a, const S& b) { return {a.sum + b.sum, a.len + b.len}; }
+    static S e() { return {0, 0}; }
+    static S mapping(const F& f, const S& x) { return f == NONE ? x : S{f * x.len, x.len}; }
+    static F composition(const F& f, const F& g) { return f == NONE ? g : f; }
+    static F id() { return NONE; }
+};
+
+struct AffineSumLazy {
+    struct S { ll sum; int len; };
+    struct F { ll a, b; };
+    static S make(ll v) { return {v % MOD, 1}; }
+    static S op(const S& x, const S& y) { return {(x.sum + y.sum) % MOD, x.len + y.len}; }
+    static S e() { return {0, 0}; }
+    static S mapping(const F& f, const S& x) { return {(f.a * x.sum + f.b * x.len) % MOD, x.len}; }
+    static F composition(const F& f, const F& g) { return {f.a * g.a % MOD, (f.a * g.b + f.b) % MOD}; }
+    static F id() { return {1, 0}; }
+};
+
+struct ChminChmaxAddSumLazy {
+    struct S { ll mx, mx2, mn, mn2, sum; int cmx, cmn, len; bool fail; };
+    struct F { ll add, lo, hi; };
+    static S make(ll v) { return {v, -INF64, v, INF64, v, 1, 1, 1, false}; }
+    static S e() { return {-INF64, -INF64, INF64, INF64, 0, 0, 0, 0, false}; }
+    static S op(const S& a, const S& b) {
+        if (!a.len) return b;
+        if (!b.len) return a;
+        S r;
+        r.sum = a.sum + b.sum;
+        r.len = a.len + b.len;
+        r.fail = false;
+        if (a.mx == b.mx) r.mx = a.mx, r.cmx = a.cmx + b.cmx, r.mx2 = max(a.mx2, b.mx2);
+        else if (a.mx > b.mx) r.mx = a.mx, r.cmx = a.cmx, r.mx2 = max(a.mx2, b.mx);
+        else r.mx = b.mx, r.cmx = b.cmx, r.mx2 = max(a.mx, b.mx2);
+        if (a.mn == b.mn) r.mn = a.mn, r.cmn = a.cmn + b.cmn, r.mn2 = min(a.mn2, b.mn2);
+        else if (a.mn < b.mn) r.mn = a.mn, r.cmn = a.cmn, r.mn2 = min(a.mn2, b.mn);
+        else r.mn = b.mn, r.cmn = b.cmn, r.mn2 = min(a.mn, b.mn2);
+        return r;
+    }
+    static S mapping(const F& f, S x) {
+        if (!x.len) return x;
+        if (f.add) {
+            x.mx += f.add;
+            x.mn += f.add;
+            if (x.mx2 != -INF64) x.mx2 += f.add;
+            if (x.mn2 != INF64) x.mn2 += f.add;
+            x.sum += f.add * x.len;
+        }
+        if (x.mn < f.lo) {
+            if (x.mn2 <= f.lo) { x.fail = true; return x; }
+            x.sum += (f.lo - x.mn) * x.cmn;
+            if (x.mx == x.mn) x.mx = f.lo;
+            else if (x.mx2 == x.mn) x.mx2 = f.lo;
+            x.mn = f.lo;
+        }
+        if (x.mx > f.hi) {
+            if (x.mx2 >= f.hi) { x.fail = true; return x; }
+            x.sum -= (x.mx - f.hi) * x.cmx;
+            if (x.mn == x.mx) x.mn = f.hi;
+            else if (x.mn2 == x.mx) x.mn2 = f.hi;
+            x.mx = f.hi;
+        }
+        return x;
+    }
+    static F composition(const F& f, const F& g) {
+        return {f.add + g.add, clamp(g.lo + f.add, f.lo, f.hi), clamp(g.hi + f.add, f.lo, f.hi)};
+    }
+    static F id() { return {0, -INF64, INF64}; }
+    static F chmin(ll v) { return {0, -INF64, v}; }
+    static F chmax(ll v) { return {0, v, INF64}; }
+    static F add(ll v) { return {v, -INF64, INF64}; }
+    static bool failed(const S& x) { return x.fail; }
+};
+
+template <class P, class = void>
+struct lazy_can_fail : false_type {};
+template <class P>
+struct lazy_can_fail<P, void_t<decltype(P::failed(declval<const typename P::S&>()))>> : true_type {};
+
+template <class P>
 struct LazySegTree {
-    int n;
-    F merge;
-    T neutral, lazy_neutral;
-    unique_ptr<T[]> st, lz;
-    function<void(T&, T, int, int)> apply;
-    LazySegTree(int n, F merge, T neutral, T lazy_neutral, function<void(T&, T, int, int)> apply)
-        : n(n), merge(merge), neutral(neutral), lazy_neutral(lazy_neutral), st(new T[4 * n]), lz(new T[4 * n]), apply(apply) {
-        fill(lz.get(), lz.get() + 4 * n, lazy_neutral);
-    }
-    void build(const vector<T>& v, int p, int l, int r) {
-        if (l == r) { st[p] = v[l]; return; }
-        int m = (l + r) >> 1;
-        build(v, p << 1, l, m);
-        build(v, p << 1 | 1, m + 1, r);
-        st[p] = merge(st[p << 1], st[p << 1 | 1]);
-    }
-    void push(int p, int l, int r) {
-        if (lz[p] == lazy_neutral) return;
-        int m = (l + r) >> 1;
-        apply(st[p << 1], lz[p], l, m);
-        apply(st[p << 1 | 1], lz[p], m + 1, r);
-        if (lz[p << 1] == lazy_neutral) lz[p << 1] = lz[p]; else lz[p << 1] += lz[p];
-        if (lz[p << 1 | 1] == lazy_neutral) lz[p << 1 | 1] = lz[p]; else lz[p << 1 | 1] += lz[p];
-        lz[p] = lazy_neutral;
-    }
-    void range_update(int p, int l, int r, int ql, int qr, T val) {
-        if (qr < l || r < ql) return;
-        if (ql <= l && r <= qr) {
-            apply(st[p], val, l, r);
-            if (lz[p] == lazy_neutral) lz[p] = val; else lz[p] += val;
-            return;
-        }
-        push(p, l, r);
-        int m = (l + r) >> 1;
-        range_update(p << 1, l, m, ql, qr, val);
-        range_update(p << 1 | 1, m + 1, r, ql, qr, val);
-        st[p] = merge(st[p << 1], st[p << 1 | 1]);
-    }
-    T query(int p, int l, int r, int ql, int qr) {
-        if (qr < l || r < ql) return neutral;
-        if (ql <= l && r <= qr) return st[p];
-        push(p, l, r);
-        int m = (l + r) >> 1;
-        return merge(query(p << 1, l, m, ql, qr), query(p << 1 | 1, m + 1, r, ql, qr));
+    using S = typename P::S;
+    using F = typename P::F;
+    int n, h;
+    vector<S> d;
+    vector<F> lz;
+    LazySegTree(int n = 0) : LazySegTree(vector<S>(n, P::e())) {}
+    LazySegTree(const vector<S>& v) : n(SZ(v)), h(32 - __builtin_clz(max(n, 1))), d(2 * n), lz(n, P::id()) {
+        copy(ALL(v), d.begin() + n);
+        for (int i = n - 1; i > 0; i--) pull(i);
+    }
+    void pull(int k) { d[k] = P::op(d[k << 1], d[k << 1 | 1]); }
+    void all_apply(int k, const F& f) {
+        d[k] = P::mapping(f, d[k]);
+        if (k < n) {
+            lz[k] = P::composition(f, lz[k]);
+            if constexpr (lazy_can_fail<P>::value) {
+                if (P::failed(d[k])) { push(k); pull(k); }
+            }
+        }
+    }
+    void push(int k) {
+        all_apply(k << 1, lz[k]);
+        all_apply(k << 1 | 1, lz[k]);
+        lz[k] = P::id();
+    }
+    void push_bounds(int l, int r) {
+        for (int i = h; i > 0; i--) {
+            if ((l >> i) && ((l >> i) << i) != l) push(l >> i);
+            if (((r - 1) >> i) && ((r >> i) << i) != r) push((r - 1) >> i);
+        }
+    }
+    S get(int idx) {
+        idx += n;
+        for (int i = h; i > 0; i--) if (idx >> i) push(idx >> i);
+        return d[idx];
+    }
+    void set(int idx, const S& val) {
+        idx += n;
+        for (int i = h; i > 0; i--) if (idx >> i) push(idx >> i);
+        d[idx] = val;
+        while (idx >>= 1) pull(idx);
+    }
+    S query(int l, int r) {
+        if (l > r) return P::e();
+        l += n; r += n + 1;
+        push_bounds(l, r);
+        S resl = P::e(), resr = P::e();
+        for (; l < r; l >>= 1, r >>= 1) {
+            if (l & 1) resl = P::op(resl, d[l++]);
+            if (r & 1) resr = P::op(d[--r], resr);
+        }
+        return P::op(resl, resr);
+    }
+    void range_update(int l, int r, const F& f) {
+        if (l > r) return;
+        l += n; r += n + 1;
+        push_bounds(l, r);
+        for (int a = l, b = r; a < b; a >>= 1, b >>= 1) {
+            if (a & 1) all_apply(a++, f);
+            if (b & 1) all_apply(--b, f);
+        }
+        for (int i = 1; i <= h; i++) {
+            if ((l >> i) && ((l >> i) << i) != l) pull(l >> i);
+            if (((r - 1) >> i) && ((r >> i) << i) != r) pull((r - 1) >> i);
+        }
     }
 };
 
@@ -180,85 +431,371 @@ template <class T, class F>
 struct SparseTable {
     int n, K;
     F op;
-    vector<vector<T>> st;
+    vector<T> st;
     SparseTable(const vector<T>& v, F op) : n(SZ(v)), op(op) {
         K = 1;
         while ((1 << K) <= n) ++K;
-        st.assign(K, vector<T>(n));
-        st[0] = v;
+        st.resize((size_t)K * n);
+        copy(ALL(v), st.begin());
         for (int k = 1; k < K; k++) {
-            for (int i = 0; i + (1 << k) <= n; i++) {
-                st[k][i] = op(st[k - 1][i], st[k - 1][i + (1 << (k - 1))]);
-            }
+            const T* prv = st.data() + (size_t)(k - 1) * n;
+            T* cur = st.data() + (size_t)k * n;
+            for (int i = 0; i + (1 << k) <= n; i++) cur[i] = op(prv[i], prv[i + (1 << (k - 1))]);
         }
     }
     T query(int l, int r) const {
         int k = 31 - __builtin_clz(r - l + 1);
-        return op(st[k][l], st[k][r - (1 << k) + 1]);
+        return op(st[(size_t)k * n + l], st[(size_t)k * n + r - (1 << k) + 1]);
+    }
+};
+
+template <class T, class Cmp = less<T>>
+struct LinearRMQ {
+    static const int B = 32;
+    int n, nb;
+    vector<T> a;
+    vector<uint32_t> mask;
+    vector<int> st;
+    Cmp cmp;
+    LinearRMQ(vector<T> v = {}, Cmp cmp = Cmp()) : n(SZ(v)), nb(SZ(v) / B), a(move(v)), mask(n), cmp(cmp) {
+        uint32_t cur = 0;
+        REP(i, n) {
+            cur <<= 1;
+            while (cur && !cmp(a[i - __builtin_ctz(cur)], a[i])) cur &= cur - 1;
+            mask[i] = cur |= 1;
+        }
+        int K = 1;
+        while ((1 << K) <= nb) ++K;
+        st.resize((size_t)K * nb);
+        REP(i, nb) st[i] = small(B * i + B - 1, B);
+        for (int k = 1; k < K; k++) {
+            for (int i = 0; i + (1 << k) <= nb; i++) {
+                st[(size_t)k * nb + i] = better(st[(size_t)(k - 1) * nb + i], st[(size_t)(k - 1) * nb + i + (1 << (k - 1))]);
+            }
+        }
+    }
+    int better(int i, int j) const { return cmp(a[j], a[i]) ? j : i; }
+    int small(int r, int len) const {
+        uint32_t m = len == B ? mask[r] : mask[r] & ((1U << len) - 1);
+        return r - (31 - __builtin_clz(m));
+    }
+    int index_query(int l, int r) const {
+        if (r - l + 1 <= B) return small(r, r - l + 1);
+        int res = better(small(l + B - 1, B), small(r, B));
+        int x = l / B + 1, y = r / B - 1;
+        if (x <= y) {
+            int k = 31 - __builtin_clz(y - x + 1);
+            res = better(res, better(st[(size_t)k * nb + x], st[(size_t)k * nb + y - (1 << k) + 1]));
+        }
+        return res;
+    }
+    T query(int l, int r) const { return a[index_query(l, r)]; }
+};
+
+template <class T, class F>
+struct DisjointSparseTable {
+    int n, K;
+    F op;
+    vector<T> st;
+    DisjointSparseTable(const vector<T>& v, F op) : n(SZ(v)), op(op) {
+        K = 1;
+        while ((1 << K) < n) ++K;
+        st.resize((size_t)K * n);
+        copy(ALL(v), st.begin());
+        for (int k = 1; k < K; k++) {
+            T* cur = st.data() + (size_t)k * n;
+            for (int s = 0; s < n; s += 2 << k) {
+                int mid = min(s + (1 << k), n), e = min(s + (2 << k), n);
+                cur[mid - 1] = v[mid - 1];
+                for (int i = mid - 2; i >= s; i--) cur[i] = op(v[i], cur[i + 1]);
+                if (mid == n) continue;
+                cur[mid] = v[mid];
+                for (int i = mid + 1; i < e; i++) cur[i] = op(cur[i - 1], v[i]);
+            }
+        }
+    }
+    T query(int l, int r) const {
+        if (l == r) return st[l];
+        int k = 31 - __builtin_clz(l ^ r);
+        return op(st[(size_t)k * n + l], st[(size_t)k * n + r]);
     }
 };
 
 struct Treap {
     struct Node {
-        int key, prior, sz;
+        int key;
+        uint32_t prior;
+        int l, r, sz;
         ll add;
-        Node *l, *r;
-        Node(int key, int prior) : key(key), prior(prior), sz(1), add(0), l(nullptr), r(nullptr) {}
     };
+    vector<Node> t;
+    vector<int> freed;
+    int root = 0;
     RNG rng;
-    Treap() {}
-    int getsz(Node* t) { return t ? t->sz : 0; }
-    void push(Node* t) {
-        if (t && t->add) {
-            if (t->l) { t->l->key += t->add; t->l->add += t->add; }
-            if (t->r) { t->r->key += t->add; t->r->add += t->add; }
-            t->add = 0;
-        }
-    }
-    void pull(Node* t) {
-        if (t) t->sz = 1 + getsz(t->l) + getsz(t->r);
-    }
-    void split(Node* t, int key, Node*& l, Node*& r) {
-        if (!t) { l = r = nullptr; return; }
-        push(t);
-        if (t->key <= key) {
-            split(t->r, key, t->r, r);
-            l = t;
+    Treap(int cap = 0) {
+        t.reserve(cap + 1);
+        t.push_back({0, 0, 0, 0, 0, 0});
+    }
+    void clear() {
+        t.resize(1);
+        freed.clear();
+        root = 0;
+    }
+    int new_node(int key) {
+        Node nd{key, (uint32_t)rng.rng(), 0, 0, 1, 0};
+        if (!freed.empty()) {
+            int v = freed.back(); freed.pop_back();
+            t[v] = nd;
+            return v;
+        }
+        t.push_back(nd);
+        return SZ(t) - 1;
+    }
+    int getsz(int v) const { return t[v].sz; }
+    int size() const { return t[root].sz; }
+    void push(int v) {
+        if (v && t[v].add) {
+            for (int c : {t[v].l, t[v].r}) if (c) { t[c].key += t[v].add; t[c].add += t[v].add; }
+            t[v].add = 0;
+        }
+    }
+    void pull(int v) {
+        if (v) t[v].sz = 1 + t[t[v].l].sz + t[t[v].r].sz;
+    }
+    void split(int v, int key, int& l, int& r) {
+        if (!v) { l = r = 0; return; }
+        push(v);
+        if (t[v].key <= key) {
+            split(t[v].r, key, t[v].r, r);
+            l = v;
         } else {
-            split(t->l, key, l, t->l);
-            r = t;
+            split(t[v].l, key, l, t[v].l);
+            r = v;
         }
-        pull(t);
+        pull(v);
     }
-    void merge(Node*& t, Node* l, Node* r) {
-        if (!l || !r) t = l ? l : r;
-        else if (l->prior > r->prior) {
+    int merge(int l, int r) {
+        if (!l || !r) return l | r;
+        if (t[l].prior > t[r].prior) {
             push(l);
-            merge(l->r, l->r, r);
-            t = l;
+            t[l].r = merge(t[l].r, r);
+            pull(l);
+            return l;
+        }
+        push(r);
+        t[r].l = merge(l, t[r].l);
+        pull(r);
+        return r;
+    }
+    void insert(int key) {
+        int l, r;
+        split(root, key, l, r);
+        root = merge(merge(l, new_node(key)), r);
+    }
+    bool erase(int key) {
+        int l, m, r;
+        split(root, key - 1, l, r);
+        split(r, key, m, r);
+        bool found = m != 0;
+        if (found) {
+            push(m);
+            freed.push_back(m);
+            m = merge(t[m].l, t[m].r);
+        }
+        root = merge(merge(l, m), r);
+        return found;
+    }
+    int count_less(int key) {
+        int res = 0;
+        for (int v = root; v;) {
+            push(v);
+            if (t[v].key < key) { res += t[t[v].l].sz + 1; v = t[v].r; }
+            else v = t[v].l;
+        }
+        return res;
+    }
+    int kth(int k) {
+        int v = root;
+        while (true) {
+            push(v);
+            int ls = t[t[v].l].sz;
+            if (k < ls) v = t[v].l;
+            else if (k == ls) return t[v].key;
+            else { k -= ls + 1; v = t[v].r; }
+        }
+    }
+    void add_all(ll val) {
+        if (root) { t[root].key += val; t[root].add += val; }
+    }
+    int unite(int a, int b) {
+        if (!a || !b) return a | b;
+        if (t[a].prior < t[b].prior) swap(a, b);
+        push(a);
+        int l, r;
+        split(b, t[a].key, l, r);
+        t[a].l = unite(t[a].l, l);
+        t[a].r = unite(t[a].r, r);
+        pull(a);
+        return a;
+    }
+    int build_sorted(const vector<int>& keys) {
+        if (!is_sorted(ALL(keys))) throw invalid_argument("Treap::build_sorted: keys must be sorted");
+        if (keys.empty()) return root;
+        vector<int> st;
+        for (int key : keys) {
+            int v = new_node(key), last = 0;
+            while (!st.empty() && t[st.back()].prior < t[v].prior) {
+                last = st.back(); st.pop_back();
+                pull(last);
+            }
+            t[v].l = last;
+            if (!st.empty()) t[st.back()].r = v;
+            st.push_back(v);
+        }
+        for (int i = SZ(st) - 1; i >= 0; i--) pull(st[i]);
+        int b = st[0], v = root;
+        while (v && t[v].r) {
+            push(v);
+            v = t[v].r;
+        }
+        return root = !v || t[v].key <= keys[0] ? merge(root, b) : unite(root, b);
+    }
+};
+
+struct ImplicitTreap {
+    struct Node {
+        ll val, sum, add;
+        uint32_t prior;
+        int l, r, sz;
+        bool rev;
+    };
+    vector<Node> t;
+    vector<int> freed;
+    int root = 0;
+    RNG rng;
+    ImplicitTreap(int cap = 0) {
+        t.reserve(cap + 1);
+        t.push_back({0, 0, 0, 0, 0, 0, 0, false});
+    }
+    void clear() {
+        t.resize(1);
+        freed.clear();
+        root = 0;
+    }
+    int new_node(ll val) {
+        Node nd{val, val, 0, (uint32_t)rng.rng(), 0, 0, 1, false};
+        if (!freed.empty()) {
+            int v = freed.back(); freed.pop_back();
+            t[v] = nd;
+            return v;
+        }
+        t.push_back(nd);
+        return SZ(t) - 1;
+    }
+    int size() const { return t[root].sz; }
+    void apply_add(int v, ll x) {
+        if (!v) return;
+        t[v].val += x;
+        t[v].sum += x * t[v].sz;
+        t[v].add += x;
+    }
+    void push(int v) {
+        if (!v) return;
+        if (t[v].rev) {
+            swap(t[v].l, t[v].r);
+            t[t[v].l].rev ^= 1;
+            t[t[v].r].rev ^= 1;
+            t[v].rev = false;
+        }
+        if (t[v].add) {
+            apply_add(t[v].l, t[v].add);
+            apply_add(t[v].r, t[v].add);
+            t[v].add = 0;
+        }
+    }
+    void pull(int v) {
+        if (!v) return;
+        const Node &a = t[t[v].l], &b = t[t[v].r];
+        t[v].sz = 1 + a.sz + b.sz;
+        t[v].sum = t[v].val + a.sum + b.sum;
+    }
+    void split(int v, int k, int& l, int& r) {
+        if (!v) { l = r = 0; return; }
+        push(v);
+        int ls = t[t[v].l].sz;
+        if (k <= ls) {
+            split(t[v].l, k, l, t[v].l);
+            r = v;
         } else {
-            push(r);
-            merge(r->l, l, r->l);
-            t = r;
-        }
-        pull(t);
-    }
-    void insert(Node*& t, Node* it) {
-        if (!t) t = it;
-        else if (it->prior > t->prior) {
-            split(t, it->key, it->l, it->r);
-            t = it;
-        } else insert(it->key < t->key ? t->l : t->r, it);
-        pull(t);
-    }
-    void erase(Node*& t, int key) {
-        if (!t) return;
-        if (t->key == key) {
-            Node* tmp = t;
-            merge(t, t->l, t->r);
-            delete tmp;
-        } else erase(key < t->key ? t->l : t->r, key);
-        pull(t);
+            split(t[v].r, k - ls - 1, t[v].r, r);
+            l = v;
+        }
+        pull(v);
+    }
+    int merge(int l, int r) {
+        if (!l || !r) return l | r;
+        if (t[l].prior > t[r].prior) {
+            push(l);
+            t[l].r = merge(t[l].r, r);
+            pull(l);
+            return l;
+        }
+        push(r);
+        t[r].l = merge(l, t[r].l);
+        pull(r);
+        return r;
+    }
+    void insert(int pos, ll val) {
+        int l, r;
+        split(root, pos, l, r);
+        root = merge(merge(l, new_node(val)), r);
+    }
+    void erase(int pos) {
+        int l, m, r;
+        split(root, pos, l, r);
+        split(r, 1, m, r);
+        if (m) freed.push_back(m);
+        root = merge(l, r);
+    }
+    template <class G>
+    void on_range(int lo, int hi, G g) {
+        int l, m, r;
+        split(root, lo, l, r);
+        split(r, hi - lo + 1, m, r);
+        g(m);
+        root = merge(merge(l, m), r);
+    }
+    void reverse(int l, int r) { on_range(l, r, [&](int m) { if (m) t[m].rev ^= 1; }); }
+    void range_add(int l, int r, ll x) { on_range(l, r, [&](int m) { apply_add(m, x); }); }
+    ll range_sum(int l, int r) {
+        ll res = 0;
+        on_range(l, r, [&](int m) { res = t[m].sum; });
+        return res;
+    }
+    ll get(int pos) {
+        int v = root;
+        while (true) {
+            push(v);
+            int ls = t[t[v].l].sz;
+            if (pos < ls) v = t[v].l;
+            else if (pos == ls) return t[v].val;
+            else { pos -= ls + 1; v = t[v].r; }
+        }
+    }
+    int build(const vector<ll>& vals) {
+        vector<int> st;
+        for (ll x : vals) {
+            int v = new_node(x), last = 0;
+            while (!st.empty() && t[st.back()].prior < t[v].prior) {
+                last = st.back(); st.pop_back();
+                pull(last);
+            }
+            t[v].l = last;
+            if (!st.empty()) t[st.back()].r = v;
+            st.push_back(v);
+        }
+        for (int i = SZ(st) - 1; i >= 0; i--) pull(st[i]);
+        return root = merge(root, st.empty() ? 0 : st[0]);
     }
 };
 
@@ -291,37 +828,95 @@ struct Line {
     ll get(ll x) const { return m * x + b; }
 };
 
+template <class M = MinMonoid<ll>>
 struct LiChao {
     struct Node {
         Line ln;
-        Node* left;
-        Node* right;
-        Node(Line ln) : ln(ln), left(nullptr), right(nullptr) {}
+        int left, right;
+        bool empty;
     };
     ll lo, hi;
-    Node* root;
-    LiChao(ll lo, ll hi) : lo(lo), hi(hi), root(nullptr) {}
-    void add_line(Line nw) { add_line(root, lo, hi, nw); }
-    ll query(ll x) const { return query(root, lo, hi, x); }
+    vector<ll> xs;
+    vector<Node> t;
+    int root = -1;
+    LiChao(ll lo, ll hi) : lo(lo), hi(hi) {}
+    LiChao(vector<ll> pts) : xs(move(pts)) {
+        sort(ALL(xs));
+        xs.erase(unique(ALL(xs)), xs.end());
+        lo = 0;
+        hi = SZ(xs) - 1;
+    }
+    void reset() {
+        t.clear();
+        root = -1;
+    }
+    void add_line(Line nw) { root = insert(root, lo, hi, nw); }
+    void add_segment(Line nw, ll xl, ll xr) {
+        if (!xs.empty()) {
+            xl = lower_bound(ALL(xs), xl) - xs.begin();
+            xr = upper_bound(ALL(xs), xr) - xs.begin() - 1;
+        }
+        if (max(xl, lo) > min(xr, hi)) return;
+        root = segment(root, lo, hi, xl, xr, nw);
+    }
+    ll query(ll x) const {
+        ll i = x;
+        if (!xs.empty()) {
+            i = lower_bound(ALL(xs), x) - xs.begin();
+            if (i == SZ(xs) || xs[i] != x) throw invalid_argument("LiChao: query point not in the constructor's point set");
+        }
+        ll l = lo, r = hi;
+        ll res = M::id();
+        for (int v = root; v >= 0;) {
+            if (!t[v].empty) res = M::op(res, t[v].ln.get(x));
+            if (l == r) break;
+            ll mid = (l + r) >> 1;
+            if (i <= mid) { v = t[v].left; r = mid; }
+            else { v = t[v].right; l = mid + 1; }
+        }
+        return res;
+    }
 private:
-    void add_line(Node*& node, ll l, ll r, Line nw) {
-        if (!node) { node = new Node(nw); return; }
-        ll mid = (l + r) >> 1;
-        bool lef = nw.get(l) < node->ln.get(l);
-        bool m = nw.get(mid) < node->ln.get(mid);
-        if (m) swap(nw, node->ln);
-        if (l == r) return;
-        if (lef != m) add_line(node->left, l, mid, nw);
-        else add_line(node->right, mid + 1, r, nw);
-    }
-    ll query(Node* node, ll l, ll r, ll x) const {
-        if (!node) return (ll)4e18;
-        ll res = node->ln.get(x);
-        if (l == r) return res;
+    static bool better(ll a, ll b) { return a != b && M::op(a, b) == a; }
+    ll coord(ll i) const { return xs.empty() ? i : xs[i]; }
+    int make(Line ln, bool empty = false) {
+        t.push_back({ln, -1, -1, empty});
+        return SZ(t) - 1;
+    }
+    int insert(int v, ll l, ll r, Line nw) {
+        if (v < 0) return make(nw);
+        int top = v;
+        while (true) {
+            if (t[v].empty) {
+                t[v].ln = nw;
+                t[v].empty = false;
+                break;
+            }
+            ll mid = (l + r) >> 1;
+            bool lef = better(nw.get(coord(l)), t[v].ln.get(coord(l)));
+            bool m = better(nw.get(coord(mid)), t[v].ln.get(coord(mid)));
+            if (m) swap(nw, t[v].ln);
+            if (l == r) break;
+            if (lef != m) {
+                if (t[v].left < 0) { int c = make(nw); t[v].left = c; break; }
+                v = t[v].left; r = mid;
+            } else {
+                if (t[v].right < 0) { int c = make(nw); t[v].right = c; break; }
+                v = t[v].right; l = mid + 1;
+            }
+        }
+        return top;
+    }
+    int segment(int v, ll l, ll r, ll ql, ll qr, Line nw) {
+        if (qr < l || r < ql) return v;
+        if (ql <= l && r <= qr) return insert(v, l, r, nw);
+        if (v < 0) v = make({0, M::id()}, true);
         ll mid = (l + r) >> 1;
-        if (x <= mid) res = min(res, query(node->left, l, mid, x));
-        else res = min(res, query(node->right, mid + 1, r, x));
-        return res;
+        int c = segment(t[v].left, l, mid, ql, qr, nw);
+        t[v].left = c;
+        c = segment(t[v].right, mid + 1, r, ql, qr, nw);
+        t[v].right = c;
+        return v;
     }
 };
 
@@ -350,6 +945,315 @@ struct LineContainer : multiset<HullLine, less<>> {
         auto l = *lower_bound(x);
         return l.k * x + l.m;
     }
+    vector<ll> query_sorted(const vector<ll>& xs) const {
+        vector<ll> res(SZ(xs));
+        auto it = begin();
+        REP(i, SZ(xs)) {
+            while (it->p < xs[i]) ++it;
+            res[i] = it->k * xs[i] + it->m;
+        }
+        return res;
+    }
+};
+
+struct MonotoneCHT {
+    vector<ll> k, m;
+    int ptr = 0;
+    int size() const { return SZ(k); }
+    ll eval(int i, ll x) const { return k[i] * x + m[i]; }
+    static __int128 floor_div(__int128 a, __int128 b) { return a / b - ((a % b) < 0); }
+    static bool frac_le(__int128 n1, __int128 d1, __int128 n2, __int128 d2) {
+        __int128 q1 = floor_div(n1, d1), q2 = floor_div(n2, d2);
+        if (q1 != q2) return q1 < q2;
+        return (unsigned __int128)(n1 - q1 * d1) * d2 <= (unsigned __int128)(n2 - q2 * d2) * d1;
+    }
+    bool bad(int a, int b, ll nk, ll nm) const {
+        return frac_le((__int128)m[a] - nm, (__int128)nk - k[a], (__int128)m[a] - m[b], (__int128)k[b] - k[a]);
+    }
+    void add(ll nk, ll nm) {
+        if (!k.empty() && k.back() == nk) {
+            if (m.back() >= nm) return;
+            k.pop_back(); m.pop_back();
+        }
+        while (SZ(k) >= 2 && bad(SZ(k) - 2, SZ(k) - 1, nk, nm)) { k.pop_back(); m.pop_back(); }
+        k.push_back(nk);
+        m.push_back(nm);
+        ptr = min(ptr, SZ(k) - 1);
+    }
+    ll query(ll x) const {
+        int lo = 0, hi = SZ(k) - 1;
+        while (lo < hi) {
+            int mid = (lo + hi) >> 1;
+            if (eval(mid, x) >= eval(mid + 1, x)) hi = mid;
+            else lo = mid + 1;
+        }
+        return eval(lo, x);
+    }
+    ll query_monotone(ll x) {
+        while (ptr + 1 < SZ(k) && eval(ptr + 1, x) >= eval(ptr, x)) ++ptr;
+        return eval(ptr, x);
+    }
+    vector<ll> query_sorted(const vector<ll>& xs) const {
+        vector<ll> res(SZ(xs));
+        int p = 0;
+        REP(i, SZ(xs)) {
+            while (p + 1 < SZ(k) && eval(p + 1, xs[i]) >= eval(p, xs[i])) ++p;
+            res[i] = eval(p, xs[i]);
+        }
+        return res;
+    }
+};
+
+struct BinaryHeap {
+    using P = pair<ll, int>;
+    priority_queue<P, vector<P>, greater<P>> pq;
+    BinaryHeap(int = 0) {}
+    bool empty() const { return pq.empty(); }
+    void push(ll key, int v) { pq.push({key, v}); }
+    ll top_key() const { return pq.top().first; }
+    P pop() {
+        P r = pq.top();
+        pq.pop();
+        return r;
+    }
+    void clear() { pq = {}; }
+};
+
+struct RadixHeap {
+    using P = pair<ull, int>;
+    vector<P> bucket[65];
+    ull last = 0;
+    int sz = 0;
+    RadixHeap(int = 0) {}
+    static int bit_of(ull x) { return x ? 64 - __builtin_clzll(x) : 0; }
+    bool empty() const { return sz == 0; }
+    void push(ll key, int v) {
+        sz++;
+        bucket[bit_of((ull)key ^ last)].push_back({(ull)key, v});
+    }
+    void pull() {
+        if (!bucket[0].empty()) return;
+        int i = 1;
+        while (bucket[i].empty()) i++;
+        last = min_element(ALL(bucket[i]))->first;
+        for (auto& x : bucket[i]) bucket[bit_of(x.first ^ last)].push_back(x);
+        bucket[i].clear();
+    }
+    ll top_key() {
+        pull();
+        return (ll)last;
+    }
+    pair<ll, int> pop() {
+        pull();
+        sz--;
+        P r = bucket[0].back();
+        bucket[0].pop_back();
+        return {(ll)r.first, r.second};
+    }
+    void clear() {
+        for (auto& b : bucket) b.clear();
+        last = 0;
+        sz = 0;
+    }
+};
+
+template <int D = 4>
+struct DaryHeap {
+    vector<int> h, pos;
+    vector<ll> key;
+    DaryHeap(int n = 0) : pos(n, -1), key(n) {}
+    bool empty() const { return h.empty(); }
+    void place(int i, int v) {
+        h[i] = v;
+        pos[v] = i;
+    }
+    void sift_up(int i) {
+        int v = h[i];
+        while (i > 0) {
+            int p = (i - 1) / D;
+            if (key[h[p]] <= key[v]) break;
+            place(i, h[p]);
+            i = p;
+        }
+        place(i, v);
+    }
+    void sift_down(int i) {
+        int v = h[i], n = SZ(h);
+        while (true) {
+            int c = D * i + 1;
+            if (c >= n) break;
+            int best = c;
+            for (int k = c + 1; k < min(c + D, n); k++) if (key[h[k]] < key[h[best]]) best = k;
+            if (key[h[best]] >= key[v]) break;
+            place(i, h[best]);
+            i = best;
+        }
+        place(i, v);
+    }
+    void push(ll k, int v) {
+        if (pos[v] < 0) {
+            key[v] = k;
+            h.push_back(v);
+            sift_up(SZ(h) - 1);
+        } else if (k < key[v]) {
+            key[v] = k;
+            sift_up(pos[v]);
+        }
+    }
+    ll top_key() const { return key[h[0]]; }
+    pair<ll, int> pop() {
+        int v = h[0];
+        pos[v] = -1;
+        if (SZ(h) > 1) {
+            h[0] = h.back();
+            h.pop_back();
+            sift_down(0);
+        } else h.pop_back();
+        return {key[v], v};
+    }
+    void clear() {
+        for (int v : h) pos[v] = -1;
+        h.clear();
+    }
+};
+
+inline void write_raw(FILE* f, const void* p, size_t size, size_t k) {
+    if (k && fwrite(p, size, k, f) != k) throw runtime_error("write_raw: short write");
+}
+
+inline void read_raw(FILE* f, void* p, size_t size, size_t k) {
+    if (k && fread(p, size, k, f) != k) throw runtime_error("read_raw: truncated input");
+}
+
+inline ll remaining_bytes(FILE* f) {
+    long pos = ftell(f);
+    if (pos < 0 || fseek(f, 0, SEEK_END)) return -1;
+    long end = ftell(f);
+    if (fseek(f, pos, SEEK_SET)) throw runtime_error("remaining_bytes: seek failed");
+    return end - pos;
+}
+
+template <class T>
+void write_vec(FILE* f, const vector<T>& v) {
+    ull k = SZ(v);
+    write_raw(f, &k, sizeof k, 1);
+    write_raw(f, v.data(), sizeof(T), k);
+}
+
+template <class T>
+void read_vec(FILE* f, vector<T>& v) {
+    ull k;
+    read_raw(f, &k, sizeof k, 1);
+    ll rem = remaining_bytes(f);
+    if (rem >= 0 && k > (ull)rem / sizeof(T)) throw runtime_error("read_vec: length exceeds remaining input");
+    v.clear();
+    for (ull got = 0; got < k;) {
+        ull c = min<ull>(k - got, 1 << 20);
+        v.resize(got + c);
+        read_raw(f, v.data() + got, sizeof(T), c);
+        got += c;
+    }
+}
+
+struct BitRank {
+    int n;
+    vector<ull> w;
+    vector<uint32_t> cnt;
+    BitRank(int n = 0) : n(n), w(n / 64 + 1), cnt((n / 64 + 4) / 4) {}
+    void set(int i) { w[i >> 6] |= 1ULL << (i & 63); }
+    void build() {
+        uint32_t c = 0;
+        REP(i, SZ(w)) {
+            if (!(i & 3)) cnt[i >> 2] = c;
+            c += __builtin_popcountll(w[i]);
+        }
+    }
+    bool operator[](int i) const { return w[i >> 6] >> (i & 63) & 1; }
+    int rank1(int i) const {
+        int b = i >> 6, r = cnt[b >> 2];
+        for (int k = b & ~3; k < b; k++) r += __builtin_popcountll(w[k]);
+        return r + __builtin_popcountll(w[b] & ((1ULL << (i & 63)) - 1));
+    }
+    int rank0(int i) const { return i - rank1(i); }
+    size_t bytes() const { return w.size() * sizeof(ull) + cnt.size() * sizeof(uint32_t); }
+    void save(FILE* f) const {
+        write_raw(f, &n, sizeof n, 1);
+        write_vec(f, w);
+    }
+    void load(FILE* f) {
+        read_raw(f, &n, sizeof n, 1);
+        if (n < 0) throw runtime_error("BitRank: corrupt input");
+        read_vec(f, w);
+        if (SZ(w) != n / 64 + 1) throw runtime_error("BitRank: corrupt input");
+        cnt.assign((n / 64 + 4) / 4, 0);
+        build();
+    }
+};
+
+struct WaveletMatrix {
+    int n = 0, L = 0;
+    vector<BitRank> bits;
+    vector<int> zeros, bottom;
+    WaveletMatrix() {}
+    WaveletMatrix(vector<int> v, int L) : n(SZ(v)), L(L), bits(L, BitRank(n)), zeros(L) {
+        vector<int> tmp(n);
+        REP(k, L) {
+            int b = L - 1 - k, z = 0;
+            REP(i, n) {
+                if (v[i] >> b & 1) bits[k].set(i);
+                else z++;
+            }
+            bits[k].build();
+            zeros[k] = z;
+            int lo = 0, hi = z;
+            REP(i, n) (v[i] >> b & 1 ? tmp[hi++] : tmp[lo++]) = v[i];
+            swap(v, tmp);
+        }
+        init_bottom();
+    }
+    void init_bottom() {
+        bottom.assign(1 << L, 0);
+        REP(c, 1 << L) bottom[c] = descend(c, 0);
+    }
+    int descend(int c, int i) const {
+        REP(k, L) i = c >> (L - 1 - k) & 1 ? zeros[k] + bits[k].rank1(i) : bits[k].rank0(i);
+        return i;
+    }
+    int rank(int c, int i) const { return descend(c, i) - bottom[c]; }
+    pair<int, int> access_rank(int i) const {
+        int c = 0;
+        REP(k, L) {
+            bool b = bits[k][i];
+            c = c << 1 | b;
+            i = b ? zeros[k] + bits[k].rank1(i) : bits[k].rank0(i);
+        }
+        return {c, i - bottom[c]};
+    }
+    int access(int i) const { return access_rank(i).first; }
+    size_t bytes() const {
+        size_t r = (zeros.size() + bottom.size()) * sizeof(int);
+        for (auto& b : bits) r += b.bytes();
+        return r;
+    }
+    void save(FILE* f) const {
+        write_raw(f, &n, sizeof n, 1);
+        write_raw(f, &L, sizeof L, 1);
+        write_vec(f, zeros);
+        for (auto& b : bits) b.save(f);
+    }
+    void load(FILE* f) {
+        read_raw(f, &n, sizeof n, 1);
+        read_raw(f, &L, sizeof L, 1);
+        if (n < 0 || L < 0 || L > 30) throw runtime_error("WaveletMatrix: corrupt input");
+        read_vec(f, zeros);
+        if (SZ(zeros) != L) throw runtime_error("WaveletMatrix: corrupt input");
+        bits.assign(L, BitRank());
+        REP(k, L) {
+            bits[k].load(f);
+            if (bits[k].n != n || zeros[k] != bits[k].rank0(n)) throw runtime_error("WaveletMatrix: corrupt input");
+        }
+        init_bottom();
+    }
 };
 
 #endif
@@ -4,7 +4,81 @@
 #include "base.hpp"
 #include "ds.hpp"
 
-inline vector<int> topo_sort(const vector<vector<int>>& g) {
+struct CSRGraph {
+    struct Adj {
+        const int* b;
+        const int* e;
+        const int* begin() const { return b; }
+        const int* end() const { return e; }
+        int size() const { return int(e - b); }
+    };
+    int n = 0;
+    vector<ll> off;
+    vector<int> to, wt;
+    CSRGraph(int n = 0) : n(n), off(n + 1, 0) {}
+    CSRGraph(int n, const vector<pair<int,int>>& edges, bool directed = true) : n(n) {
+        build(SZ(edges), directed, [&](int i) { return tuple<int,int,int>{edges[i].first, edges[i].second, 0}; }, false);
+    }
+    CSRGraph(int n, const vector<tuple<int,int,int>>& edges, bool directed = true) : n(n) {
+        build(SZ(edges), directed, [&](int i) { return edges[i]; }, true);
+    }
+    explicit CSRGraph(const vector<vector<int>>& g) : n(SZ(g)), off(n + 1, 0) {
+        REP(u, n) off[u + 1] = off[u] + SZ(g[u]);
+        to.reserve(off[n]);
+        REP(u, n) to.insert(to.end(), ALL(g[u]));
+    }
+    explicit CSRGraph(const vector<vector<pair<int,int>>>& g) : n(SZ(g)), off(n + 1, 0) {
+        REP(u, n) off[u + 1] = off[u] + SZ(g[u]);
+        to.reserve(off[n]);
+        wt.reserve(off[n]);
+        REP(u, n) for (auto [v, w] : g[u]) { to.push_back(v); wt.push_back(w); }
+    }
+    template <class E>
+    void build(int m, bool directed, E edge, bool weighted) {
+        off.assign(n + 1, 0);
+        REP(i, m) {
+            auto [u, v, w] = edge(i);
+            off[u + 1]++;
+            if (!directed) off[v + 1]++;
+        }
+        REP(u, n) off[u + 1] += off[u];
+        to.resize(off[n]);
+        if (weighted) wt.resize(off[n]);
+        vector<ll> pos(off.begin(), off.end() - 1);
+        auto put = [&](int u, int v, int w) {
+            ll k = pos[u]++;
+            to[k] = v;
+            if (weighted) wt[k] = w;
+        };
+        REP(i, m) {
+            auto [u, v, w] = edge(i);
+            put(u, v, w);
+            if (!directed) put(v, u, w);
+        }
+    }
+    int size() const { return n; }
+    ll edges() const { return off[n]; }
+    int degree(int u) const { return int(off[u + 1] - off[u]); }
+    int weight(ll i) const { return wt.empty() ? 1 : wt[i]; }
+    Adj operator[](int u) const { return {to.data() + off[u], to.data() + off[u + 1]}; }
+    CSRGraph reversed() const {
+        CSRGraph r(n);
+        REP(u, n) for (ll i = off[u]; i < off[u + 1]; i++) r.off[to[i] + 1]++;
+        REP(u, n) r.off[u + 1] += r.off[u];
+        r.to.resize(off[n]);
+        if (!wt.empty()) r.wt.resize(off[n]);
+        vector<ll> pos(r.off.begin(), r.off.end() - 1);
+        REP(u, n) for (ll i = off[u]; i < off[u + 1]; i++) {
+            ll k = pos[to[i]]++;
+            r.to[k] = u;
+            if (!wt.empty()) r.wt[k] = wt[i];
+        }
+        return r;
+    }
+};
+
+template <class G>
+vector<int> topo_sort(const G& g) {
     int n = SZ(g);
     vector<int> indeg(n), res;
     for (int u = 0; u < n; u++) for (int v : g[u]) indeg[v]++;
@@ -18,7 +92,8 @@ inline vector<int> topo_sort(const vector<vector<int>>& g) {
     return res;
 }
 
-inline vector<int> bfs_levels(const vector<vector<int>>& g, int src) {
+template <class G>
+vector<int> bfs_levels(const G& g, int src) {
     int n = SZ(g);
     vector<int> dist(n, -1);
     queue<int> q;
@@ -33,102 +108,524 @@ inline vector<int> bfs_levels(const vector<vector<int>>& g, int src) {
     return dist;
 }
 
-inline void dfs_rec(int u, const vector<vector<int>>& g, vector<int>& vis, vector<int>& order) {
-    vis[u] = 1;
-    for (int v : g[u]) if (!vis[v]) dfs_rec(v, g, vis, order);
-    order.push_back(u);
+template <class G>
+vector<int> bfs_direction_opt(const G& g, const G& rg, int src, int threads = 1) {
+    int n = SZ(g), W = (n + 63) >> 6;
+    threads = thread_count(threads);
+    vector<int> level(n, -1);
+    unique_ptr<atomic<ull>[]> seen(new atomic<ull>[W]);
+    REP(i, W) seen[i].store(0, memory_order_relaxed);
+    vector<ull> front(W), next(W);
+    vector<int> cur{src};
+    vector<vector<int>> out(threads);
+    vector<ll> cnt(threads), deg(threads);
+    ll m_u = 0;
+    REP(v, n) m_u += SZ(g[v]);
+    level[src] = 0;
+    seen[src >> 6].store(1ULL << (src & 63), memory_order_relaxed);
+    m_u -= SZ(g[src]);
+    bool bottom = false;
+    ll n_f = 1;
+    for (int d = 1; n_f > 0; d++) {
+        if (!bottom) {
+            ll m_f = 0;
+            for (int v : cur) m_f += SZ(g[v]);
+            if (m_f > m_u / 15) {
+                bottom = true;
+                fill(ALL(front), 0);
+                for (int v : cur) front[v >> 6] |= 1ULL << (v & 63);
+            }
+        } else if (n_f < n / 18) {
+            bottom = false;
+            cur.clear();
+            REP(w, W) for (ull x = front[w]; x; x &= x - 1) cur.push_back(w << 6 | __builtin_ctzll(x));
+        }
+        if (!bottom) {
+            parallel_for(SZ(cur), threads, [&](ll lo, ll hi, int t) {
+                for (ll i = lo; i < hi; i++) for (int v : g[cur[i]]) {
+                    ull bit = 1ULL << (v & 63);
+                    if (seen[v >> 6].load(memory_order_relaxed) & bit) continue;
+                    if (seen[v >> 6].fetch_or(bit, memory_order_relaxed) & bit) continue;
+                    level[v] = d;
+                    out[t].push_back(v);
+                }
+            });
+            cur.clear();
+            for (auto& o : out) {
+                cur.insert(cur.end(), ALL(o));
+                o.clear();
+            }
+            n_f = SZ(cur);
+            for (int v : cur) m_u -= SZ(g[v]);
+        } else {
+            parallel_for(W, threads, [&](ll lo, ll hi, int t) {
+                cnt[t] = deg[t] = 0;
+                for (ll w = lo; w < hi; w++) {
+                    ull old = seen[w].load(memory_order_relaxed), nw = 0;
+                    ull unseen = ~old;
+                    if (w == W - 1 && (n & 63)) unseen &= (1ULL << (n & 63)) - 1;
+                    for (; unseen; unseen &= unseen - 1) {
+                        int b = __builtin_ctzll(unseen), v = int(w << 6 | b);
+                        for (int u : rg[v]) if (front[u >> 6] >> (u & 63) & 1) {
+                            level[v] = d;
+                            nw |= 1ULL << b;
+                            cnt[t]++;
+                            deg[t] += SZ(g[v]);
+                            break;
+                        }
+                    }
+                    next[w] = nw;
+                    seen[w].store(old | nw, memory_order_relaxed);
+                }
+            });
+            front.swap(next);
+            n_f = 0;
+            REP(t, threads) {
+                n_f += cnt[t];
+                m_u -= deg[t];
+            }
+        }
+    }
+    return level;
+}
+
+template <class G>
+vector<int> bfs_direction_opt(const G& g, int src, int threads = 1) {
+    return bfs_direction_opt(g, g, src, threads);
+}
+
+template <class G>
+vector<vector<int>> bfs_levels_multi64(const G& g, const G& rg, const vector<int>& srcs, int threads = 1) {
+    int n = SZ(g), k = SZ(srcs);
+    if (k > 64) throw invalid_argument("bfs_levels_multi64: at most 64 sources");
+    threads = thread_count(threads);
+    vector<vector<int>> res(k, vector<int>(n, -1));
+    vector<ull> seen(n), front(n), next(n);
+    REP(i, k) {
+        seen[srcs[i]] |= 1ULL << i;
+        front[srcs[i]] |= 1ULL << i;
+        res[i][srcs[i]] = 0;
+    }
+    ull full = k == 64 ? ~0ULL : (1ULL << k) - 1;
+    vector<char> any(threads);
+    for (int d = 1;; d++) {
+        parallel_for(n, threads, [&](ll lo, ll hi, int t) {
+            any[t] = 0;
+            for (ll v = lo; v < hi; v++) {
+                ull acc = 0;
+                if (seen[v] != full) for (int u : rg[v]) acc |= front[u];
+                acc &= ~seen[v];
+                next[v] = acc;
+                if (!acc) continue;
+                any[t] = 1;
+                seen[v] |= acc;
+                for (; acc; acc &= acc - 1) res[__builtin_ctzll(acc)][v] = d;
+            }
+        });
+        if (!count(ALL(any), 1)) break;
+        front.swap(next);
+    }
+    return res;
+}
+
+template <class G>
+vector<vector<int>> bfs_levels_multi64(const G& g, const vector<int>& srcs, int threads = 1) {
+    return bfs_levels_multi64(g, g, srcs, threads);
+}
+
+template <class G, class Enter, class Edge, class Exit>
+void dfs_iter(const G& g, int root, Enter enter, Edge edge, Exit exit) {
+    using It = decltype(g[root].begin());
+    struct Frame { int u, p; It it, end; };
+    vector<Frame> st;
+    auto push = [&](int u, int p) {
+        enter(u, p);
+        auto&& adj = g[u];
+        st.push_back({u, p, adj.begin(), adj.end()});
+    };
+    push(root, -1);
+    while (!st.empty()) {
+        Frame& f = st.back();
+        if (f.it == f.end) {
+            int u = f.u, p = f.p;
+            st.pop_back();
+            exit(u, p);
+            continue;
+        }
+        int u = f.u, v = *f.it++;
+        if (edge(u, v)) push(v, u);
+    }
+}
+
+template <class G>
+void dfs_rec(int u, const G& g, vector<int>& vis, vector<int>& order) {
+    dfs_iter(g, u,
+        [&](int x, int) { vis[x] = 1; },
+        [&](int, int y) { return !vis[y]; },
+        [&](int x, int) { order.push_back(x); });
 }
 
 struct LCA {
-    int n, L;
-    vector<vector<int>> up;
-    vector<int> depth;
-    LCA(const vector<vector<int>>& g, int root = 0) {
-        n = SZ(g);
-        L = 1;
-        while ((1 << L) <= n) ++L;
-        up.assign(L, vector<int>(n, -1));
-        depth.assign(n, 0);
-        function<void(int,int)> dfs = [&](int u, int p) {
-            up[0][u] = p;
-            for (int v : g[u]) if (v != p) {
+    int n, root;
+    vector<int> tin, order, parent, depth, dstart, bydepth;
+    LinearRMQ<int> rmq;
+    template <class G>
+    LCA(const G& g, int root = 0) : n(SZ(g)), root(root), tin(n, -1), parent(n, -1), depth(n, 0) {
+        order.reserve(n);
+        vector<int> st{root};
+        while (!st.empty()) {
+            int u = st.back(); st.pop_back();
+            tin[u] = SZ(order);
+            order.push_back(u);
+            for (int v : g[u]) if (v != parent[u]) {
+                parent[v] = u;
                 depth[v] = depth[u] + 1;
-                dfs(v, u);
-            }
-        };
-        dfs(root, -1);
-        for (int k = 1; k < L; k++) {
-            for (int v = 0; v < n; v++) {
-                int mid = up[k - 1][v];
-                up[k][v] = mid == -1 ? -1 : up[k - 1][mid];
+                st.push_back(v);
             }
         }
-    }
-    int lift(int v, int d) const {
-        for (int k = 0; k < L; k++) if (d & (1 << k)) v = up[k][v];
-        return v;
+        vector<int> up(SZ(order));
+        for (int i = 1; i < SZ(order); i++) up[i] = tin[parent[order[i]]];
+        rmq = LinearRMQ<int>(move(up));
+        dstart.assign(n + 1, 0);
+        for (int v : order) dstart[depth[v] + 1]++;
+        REP(d, n) dstart[d + 1] += dstart[d];
+        bydepth.resize(SZ(order));
+        vector<int> pos(dstart.begin(), dstart.end() - 1);
+        for (int v : order) bydepth[pos[depth[v]]++] = v;
     }
     int query(int a, int b) const {
-        if (depth[a] < depth[b]) swap(a, b);
-        a = lift(a, depth[a] - depth[b]);
         if (a == b) return a;
-        for (int k = L - 1; k >= 0; k--) if (up[k][a] != up[k][b]) {
-            a = up[k][a];
-            b = up[k][b];
+        int x = tin[a], y = tin[b];
+        if (x > y) swap(x, y);
+        return order[rmq.query(x + 1, y)];
+    }
+    int dist(int a, int b) const { return depth[a] + depth[b] - 2 * depth[query(a, b)]; }
+    int kth_ancestor(int v, int k) const {
+        if (k > depth[v]) return -1;
+        int d = depth[v] - k;
+        auto first = bydepth.begin() + dstart[d], last = bydepth.begin() + dstart[d + 1];
+        return *prev(upper_bound(first, last, tin[v], [&](int t, int u) { return t < tin[u]; }));
+    }
+    int lift(int v, int d) const { return kth_ancestor(v, d); }
+    vector<int> query_many(const vector<pair<int,int>>& qs) const {
+        int q = SZ(qs);
+        vector<int> res(q), qoff(n + 1, 0), qid(q);
+        auto later = [&](int i) { return tin[qs[i].first] > tin[qs[i].second] ? qs[i].first : qs[i].second; };
+        REP(i, q) qoff[later(i) + 1]++;
+        REP(v, n) qoff[v + 1] += qoff[v];
+        vector<int> pos(qoff.begin(), qoff.end() - 1);
+        REP(i, q) qid[pos[later(i)]++] = i;
+        DSU dsu(n);
+        vector<int> anc(n), open;
+        REP(i, SZ(order)) {
+            int v = order[i];
+            while (!open.empty() && parent[v] != open.back()) {
+                int c = open.back(); open.pop_back();
+                dsu.unite(c, parent[c]);
+                anc[dsu.find(c)] = parent[c];
+            }
+            anc[v] = v;
+            open.push_back(v);
+            for (int k = qoff[v]; k < qoff[v + 1]; k++) {
+                auto [a, b] = qs[qid[k]];
+                res[qid[k]] = anc[dsu.find(a == v ? b : a)];
+            }
         }
-        return up[0][a];
+        return res;
     }
 };
 
-inline void dijkstra(int n, const vector<vector<pair<int,int>>>& g, int src, vector<ll>& dist, vector<int>* parent = nullptr) {
+template <class F>
+void for_each_arc(const vector<vector<pair<int,int>>>& g, int u, F f) {
+    for (auto [v, w] : g[u]) f(v, w);
+}
+
+template <class F>
+void for_each_arc(const CSRGraph& g, int u, F f) {
+    for (ll i = g.off[u]; i < g.off[u + 1]; i++) f(g.to[i], g.weight(i));
+}
+
+template <class H = BinaryHeap, class G>
+void dijkstra_multi(int n, const G& g, const vector<int>& srcs, vector<ll>& dist, vector<int>* parent = nullptr, vector<int>* owner = nullptr) {
     dist.assign(n, INF64);
     if (parent) parent->assign(n, -1);
-    using P = pair<ll, int>;
-    priority_queue<P, vector<P>, greater<P>> pq;
-    dist[src] = 0; pq.push({0, src});
+    if (owner) owner->assign(n, -1);
+    H pq(n);
+    for (int s : srcs) if (dist[s] != 0) {
+        dist[s] = 0;
+        if (owner) (*owner)[s] = s;
+        pq.push(0, s);
+    }
     while (!pq.empty()) {
-        auto [d, u] = pq.top(); pq.pop();
+        auto [d, u] = pq.pop();
         if (d != dist[u]) continue;
-        for (auto [v, w] : g[u]) if (dist[v] > d + w) {
-            dist[v] = d + w;
-            if (parent) (*parent)[v] = u;
-            pq.push({dist[v], v});
+        for_each_arc(g, u, [&](int v, ll w) {
+            if (dist[v] > d + w) {
+                dist[v] = d + w;
+                if (parent) (*parent)[v] = u;
+                if (owner) (*owner)[v] = (*owner)[u];
+                pq.push(dist[v], v);
+            }
+        });
+    }
+}
+
+template <class H = BinaryHeap, class G>
+void dijkstra(int n, const G& g, int src, vector<ll>& dist, vector<int>* parent = nullptr) {
+    dijkstra_multi<H>(n, g, vector<int>{src}, dist, parent);
+}
+
+template <class G, class H = BinaryHeap>
+struct BidirectionalDijkstra {
+    const G& g;
+    const G& rg;
+    int n, meet = -1;
+    vector<ll> dist[2];
+    vector<int> par[2], touched[2];
+    H pq[2];
+    BidirectionalDijkstra(const G& g, const G& rg) : g(g), rg(rg), n(SZ(g)), pq{H(n), H(n)} {
+        REP(k, 2) {
+            dist[k].assign(n, INF64);
+            par[k].assign(n, -1);
+        }
+    }
+    void reset() {
+        REP(k, 2) {
+            for (int v : touched[k]) {
+                dist[k][v] = INF64;
+                par[k][v] = -1;
+            }
+            touched[k].clear();
+            pq[k].clear();
+        }
+        meet = -1;
+    }
+    void relax(int k, int v, ll d, int p) {
+        if (dist[k][v] == INF64) touched[k].push_back(v);
+        dist[k][v] = d;
+        par[k][v] = p;
+        pq[k].push(d, v);
+    }
+    ll query(int s, int t) {
+        reset();
+        relax(0, s, 0, -1);
+        relax(1, t, 0, -1);
+        ll best = s == t ? 0 : INF64;
+        if (s == t) meet = s;
+        while (!pq[0].empty() && !pq[1].empty()) {
+            if (pq[0].top_key() + pq[1].top_key() >= best) break;
+            int k = pq[0].top_key() <= pq[1].top_key() ? 0 : 1;
+            auto [d, u] = pq[k].pop();
+            if (d != dist[k][u]) continue;
+            for_each_arc(k ? rg : g, u, [&](int v, ll w) {
+                if (dist[k][v] > d + w) relax(k, v, d + w, u);
+                if (dist[k ^ 1][v] != INF64 && dist[k][v] + dist[k ^ 1][v] < best) {
+                    best = dist[k][v] + dist[k ^ 1][v];
+                    meet = v;
+                }
+            });
+        }
+        return best;
+    }
+    vector<int> path() const {
+        vector<int> res;
+        if (meet < 0) return res;
+        for (int v = meet; v != -1; v = par[0][v]) res.push_back(v);
+        reverse(ALL(res));
+        for (int v = par[1][meet]; v != -1; v = par[1][v]) res.push_back(v);
+        return res;
+    }
+};
+
+template <class G>
+void delta_stepping(int n, const G& g, int src, vector<ll>& dist, ll delta = 0, int threads = 1) {
+    threads = thread_count(threads);
+    if (delta <= 0) {
+        ll maxw = 1, arcs = 0;
+        REP(u, n) for_each_arc(g, u, [&](int, ll w) { maxw = max(maxw, w); arcs++; });
+        delta = max(1LL, maxw * n / max(1LL, arcs));
+    }
+    unique_ptr<atomic<ll>[]> d(new atomic<ll>[n]);
+    REP(i, n) d[i].store(INF64, memory_order_relaxed);
+    map<ll, vector<int>> bucket;
+    vector<vector<int>> out(threads);
+    vector<ll> slot(n, -1);
+    auto place = [&](int v) {
+        ll b = d[v].load(memory_order_relaxed) / delta;
+        if (slot[v] == b) return;
+        slot[v] = b;
+        bucket[b].push_back(v);
+    };
+    auto relax_from = [&](const vector<int>& from, bool light) {
+        parallel_for(SZ(from), threads, [&](ll lo, ll hi, int t) {
+            for (ll i = lo; i < hi; i++) {
+                int u = from[i];
+                ll du = d[u].load(memory_order_relaxed);
+                for_each_arc(g, u, [&](int v, ll w) {
+                    if ((w <= delta) == light && atomic_relax_min(d[v], du + w)) out[t].push_back(v);
+                });
+            }
+        });
+        for (auto& o : out) {
+            for (int v : o) place(v);
+            o.clear();
+        }
+    };
+    d[src].store(0, memory_order_relaxed);
+    place(src);
+    vector<int> cur, frontier, settled;
+    while (!bucket.empty()) {
+        ll b = bucket.begin()->first;
+        settled.clear();
+        for (auto it = bucket.begin(); it != bucket.end() && it->first == b; it = bucket.begin()) {
+            cur.swap(it->second);
+            bucket.erase(it);
+            frontier.clear();
+            for (int v : cur) if (slot[v] == b) {
+                slot[v] = -1;
+                frontier.push_back(v);
+            }
+            cur.clear();
+            settled.insert(settled.end(), ALL(frontier));
+            relax_from(frontier, true);
         }
+        sort(ALL(settled));
+        settled.erase(unique(ALL(settled)), settled.end());
+        relax_from(settled, false);
     }
+    dist.resize(n);
+    REP(i, n) dist[i] = d[i].load(memory_order_relaxed);
 }
 
-inline bool bellman_ford(int n, const vector<tuple<int,int,int>>& edges, int src, vector<ll>& dist) {
+template <class G>
+bool spfa(int n, const G& g, int src, vector<ll>& dist) {
     dist.assign(n, INF64);
+    vector<int> len(n, 0);
+    vector<char> inq(n, 0);
+    deque<int> q;
     dist[src] = 0;
-    for (int i = 0; i < n - 1; i++) {
-        bool any = false;
-        for (auto [u, v, w] : edges) {
-            if (dist[u] == INF64) continue;
-            if (dist[v] > dist[u] + w) {
-                dist[v] = dist[u] + w;
-                any = true;
+    q.push_back(src);
+    inq[src] = 1;
+    while (!q.empty()) {
+        int u = q.front(); q.pop_front();
+        inq[u] = 0;
+        bool cycle = false;
+        for_each_arc(g, u, [&](int v, ll w) {
+            if (cycle || dist[v] <= dist[u] + w) return;
+            dist[v] = dist[u] + w;
+            len[v] = len[u] + 1;
+            if (len[v] >= n) cycle = true;
+            else if (!inq[v]) {
+                inq[v] = 1;
+                if (!q.empty() && dist[v] < dist[q.front()]) q.push_front(v);
+                else q.push_back(v);
             }
-        }
-        if (!any) break;
+        });
+        if (cycle) return false;
     }
-    for (auto [u, v, w] : edges) if (dist[u] != INF64 && dist[v] > dist[u] + w) return false;
     return true;
 }
 
-inline vector<vector<ll>> floyd_warshall(vector<vector<ll>> dist) {
-    int n = SZ(dist);
-    for (int k = 0; k < n; k++) {
-        for (int i = 0; i < n; i++) if (dist[i][k] < INF64) {
-            for (int j = 0; j < n; j++) if (dist[k][j] < INF64) {
-                dist[i][j] = min(dist[i][j], dist[i][k] + dist[k][j]);
+inline bool bellman_ford(int n, const vector<tuple<int,int,int>>& edges, int src, vector<ll>& dist) {
+    return spfa(n, CSRGraph(n, edges), src, dist);
+}
+
+inline void min_plus_row(ll* cr, const ll* br, ll x, int nj) {
+    REP(j, nj) {
+        ll y = br[j] < INF64 ? x + br[j] : INF64;
+        cr[j] = min(cr[j], y);
+    }
+}
+
+inline void fw_tile(ll* c, const ll* a, const ll* b, int ld, int ni, int nj, int nk) {
+    REP(k, nk) REP(i, ni) {
+        ll x = a[(size_t)i * ld + k];
+        if (x < INF64) min_plus_row(c + (size_t)i * ld, b + (size_t)k * ld, x, nj);
+    }
+}
+
+inline void min_plus_tile(ll* c, const ll* a, const ll* b, int ld, int ni, int nj, int nk) {
+    REP(i, ni) REP(k, nk) {
+        ll x = a[(size_t)i * ld + k];
+        if (x < INF64) min_plus_row(c + (size_t)i * ld, b + (size_t)k * ld, x, nj);
+    }
+}
+
+inline void floyd_warshall_flat(vector<ll>& d, int n, int threads = 1) {
+    const int B = 64;
+    int nb = (n + B - 1) / B;
+    threads = thread_count(threads);
+    auto at = [&](int bi, int bj) { return d.data() + (size_t)bi * B * n + (size_t)bj * B; };
+    auto len = [&](int b) { return min(B, n - b * B); };
+    REP(kb, nb) {
+        int kl = len(kb);
+        fw_tile(at(kb, kb), at(kb, kb), at(kb, kb), n, kl, kl, kl);
+        parallel_for(2 * nb, threads, [&](ll lo, ll hi, int) {
+            for (ll t = lo; t < hi; t++) {
+                int b = int(t >> 1);
+                if (b == kb) continue;
+                if (t & 1) fw_tile(at(b, kb), at(b, kb), at(kb, kb), n, len(b), kl, kl);
+                else fw_tile(at(kb, b), at(kb, kb), at(kb, b), n, kl, len(b), kl);
+            }
+        });
+        parallel_for(nb, threads, [&](ll lo, ll hi, int) {
+            for (ll ib = lo; ib < hi; ib++) if (ib != kb) REP(jb, nb) if (jb != kb) {
+                min_plus_tile(at(ib, jb), at(ib, kb), at(kb, jb), n, len(ib), len(jb), kl);
             }
+        });
+    }
+}
+
+inline vector<ll> min_plus(const vector<ll>& a, const vector<ll>& b, int n, int threads = 1) {
+    const int B = 64;
+    int nb = (n + B - 1) / B;
+    vector<ll> c((size_t)n * n, INF64);
+    parallel_for(nb, thread_count(threads), [&](ll lo, ll hi, int) {
+        for (ll ib = lo; ib < hi; ib++) REP(kb, nb) REP(jb, nb) {
+            size_t ci = (size_t)ib * B * n + (size_t)jb * B;
+            min_plus_tile(c.data() + ci, a.data() + (size_t)ib * B * n + (size_t)kb * B, b.data() + (size_t)kb * B * n + (size_t)jb * B,
+                n, min(B, n - int(ib) * B), min(B, n - jb * B), min(B, n - kb * B));
+        }
+    });
+    return c;
+}
+
+inline vector<vector<ll>> floyd_warshall(const vector<vector<ll>>& dist, int threads = 1) {
+    int n = SZ(dist);
+    vector<ll> d((size_t)n * n);
+    REP(i, n) copy(ALL(dist[i]), d.begin() + (size_t)i * n);
+    floyd_warshall_flat(d, n, threads);
+    vector<vector<ll>> res(n);
+    REP(i, n) res[i].assign(d.begin() + (size_t)i * n, d.begin() + (size_t)(i + 1) * n);
+    return res;
+}
+
+inline void radix_sort_edges(vector<tuple<int,int,int>>& edges, int threads = 1) {
+    int m = SZ(edges);
+    threads = max(1, min(thread_count(threads), m / (1 << 16) + 1));
+    auto key = [](const tuple<int,int,int>& e) { return (uint32_t)get<2>(e) ^ 0x80000000u; };
+    vector<tuple<int,int,int>> buf(m);
+    vector<vector<int>> cnt(threads, vector<int>(1 << 16));
+    for (int shift = 0; shift < 32; shift += 16) {
+        parallel_for(m, threads, [&](ll lo, ll hi, int t) {
+            fill(ALL(cnt[t]), 0);
+            for (ll i = lo; i < hi; i++) cnt[t][key(edges[i]) >> shift & 0xffff]++;
+        });
+        int pos = 0;
+        REP(d, 1 << 16) REP(t, threads) {
+            int c = cnt[t][d];
+            cnt[t][d] = pos;
+            pos += c;
         }
+        parallel_for(m, threads, [&](ll lo, ll hi, int t) {
+            for (ll i = lo; i < hi; i++) buf[cnt[t][key(edges[i]) >> shift & 0xffff]++] = edges[i];
+        });
+        edges.swap(buf);
     }
-    return dist;
 }
 
-inline pair<ll, vector<pair<int,int>>> kruskal(int n, vector<tuple<int,int,int>> edges) {
-    sort(ALL(edges), [](auto& a, auto& b){ return get<2>(a) < get<2>(b); });
+inline pair<ll, vector<pair<int,int>>> kruskal(int n, vector<tuple<int,int,int>> edges, int threads = 1) {
+    radix_sort_edges(edges, threads);
     DSU dsu(n);
     ll total = 0;
     vector<pair<int,int>> chosen;
@@ -141,104 +638,579 @@ inline pair<ll, vector<pair<int,int>>> kruskal(int n, vector<tuple<int,int,int>>
     return {total, chosen};
 }
 
+inline pair<ll, vector<pair<int,int>>> boruvka_mst(int n, const vector<tuple<int,int,int>>& edges, int threads = 1) {
+    threads = thread_count(threads);
+    ConcurrentDSU dsu(n);
+    unique_ptr<atomic<ull>[]> best(new atomic<ull>[n]);
+    REP(i, n) best[i].store(~0ULL, memory_order_relaxed);
+    auto pack = [&](int e) { return (ull)((uint32_t)get<2>(edges[e]) ^ 0x80000000u) << 32 | (uint32_t)e; };
+    vector<int> active(SZ(edges));
+    iota(ALL(active), 0);
+    vector<vector<int>> keep(threads), picked(threads);
+    while (!active.empty()) {
+        parallel_for(SZ(active), threads, [&](ll lo, ll hi, int t) {
+            keep[t].clear();
+            for (ll i = lo; i < hi; i++) {
+                int e = active[i];
+                int cu = dsu.find(get<0>(edges[e])), cv = dsu.find(get<1>(edges[e]));
+                if (cu == cv) continue;
+                keep[t].push_back(e);
+                ull key = pack(e);
+                atomic_relax_min(best[cu], key);
+                atomic_relax_min(best[cv], key);
+            }
+        });
+        active.clear();
+        for (auto& k : keep) active.insert(active.end(), ALL(k));
+        parallel_for(n, threads, [&](ll lo, ll hi, int t) {
+            for (ll c = lo; c < hi; c++) {
+                ull key = best[c].load(memory_order_relaxed);
+                if (key == ~0ULL) continue;
+                best[c].store(~0ULL, memory_order_relaxed);
+                int e = (int)(uint32_t)key;
+                if (dsu.unite(get<0>(edges[e]), get<1>(edges[e]))) picked[t].push_back(e);
+            }
+        });
+    }
+    ll total = 0;
+    vector<pair<int,int>> chosen;
+    for (auto& p : picked) for (int e : p) {
+        total += get<2>(edges[e]);
+        chosen.push_back({get<0>(edges[e]), get<1>(edges[e])});
+    }
+    return {total, chosen};
+}
+
 struct BridgeFinder {
     int n, timer;
-    vector<vector<int>> g;
     vector<int> tin, low, is_art;
     vector<pair<int,int>> bridges;
-    BridgeFinder(const vector<vector<int>>& g) : n(SZ(g)), g(g), timer(0), tin(n, -1), low(n, -1), is_art(n, 0) {
-        for (int i = 0; i < n; i++) if (tin[i] == -1) dfs(i, -1);
-    }
-    void dfs(int v, int p) {
-        tin[v] = low[v] = timer++;
-        int child = 0;
-        for (int to : g[v]) if (to != p) {
-            if (tin[to] != -1) low[v] = min(low[v], tin[to]);
-            else {
-                dfs(to, v);
-                low[v] = min(low[v], low[to]);
-                if (low[to] > tin[v]) bridges.push_back({v, to});
-                if (low[to] >= tin[v] && p != -1) is_art[v] = 1;
-                ++child;
+    vector<vector<int>> bcc;
+    template <class G>
+    BridgeFinder(const G& g) : n(SZ(g)), timer(0), tin(n, -1), low(n, -1), is_art(n, 0) {
+        vector<int> par(n, -1), child(n, 0), st;
+        vector<char> skipped(n, 0);
+        auto enter = [&](int v, int p) {
+            par[v] = p;
+            tin[v] = low[v] = timer++;
+            st.push_back(v);
+        };
+        auto edge = [&](int v, int to) {
+            if (to == par[v] && !skipped[v]) {
+                skipped[v] = 1;
+                return false;
             }
-        }
-        if (p == -1 && child > 1) is_art[v] = 1;
+            if (tin[to] != -1) {
+                low[v] = min(low[v], tin[to]);
+                return false;
+            }
+            return true;
+        };
+        auto exit = [&](int v, int p) {
+            if (p == -1) {
+                if (child[v] > 1) is_art[v] = 1;
+                if (!child[v]) bcc.push_back({v});
+                st.pop_back();
+                return;
+            }
+            child[p]++;
+            low[p] = min(low[p], low[v]);
+            if (low[v] > tin[p]) bridges.push_back({p, v});
+            if (low[v] >= tin[p]) {
+                if (par[p] != -1) is_art[p] = 1;
+                bcc.emplace_back();
+                int x;
+                do {
+                    x = st.back(); st.pop_back();
+                    bcc.back().push_back(x);
+                } while (x != v);
+                bcc.back().push_back(p);
+            }
+        };
+        for (int i = 0; i < n; i++) if (tin[i] == -1) dfs_iter(g, i, enter, edge, exit);
     }
 };
 
 struct SCC {
     int n, idx;
-    vector<vector<int>> g, rg, comp;
-    vector<int> order, comp_id, vis;
-    SCC(const vector<vector<int>>& g) : n(SZ(g)), g(g), rg(n), idx(0), comp_id(n, -1), vis(n, 0) {
-        for (int u = 0; u < n; u++) for (int v : g[u]) rg[v].push_back(u);
-        for (int i = 0; i < n; i++) if (!vis[i]) dfs1(i);
-        reverse(ALL(order));
-        for (int v : order) if (comp_id[v] == -1) {
-            comp.emplace_back();
-            dfs2(v, idx++);
-        }
-    }
-    void dfs1(int u) {
-        vis[u] = 1;
-        for (int v : g[u]) if (!vis[v]) dfs1(v);
-        order.push_back(u);
-    }
-    void dfs2(int u, int id) {
-        comp_id[u] = id;
-        comp.back().push_back(u);
-        for (int v : rg[u]) if (comp_id[v] == -1) dfs2(v, id);
+    vector<vector<int>> comp;
+    vector<int> comp_id;
+    template <class G>
+    SCC(const G& g) : n(SZ(g)), idx(0), comp_id(n, -1) {
+        vector<int> tin(n, -1), low(n), st;
+        int timer = 0;
+        auto enter = [&](int u, int) {
+            tin[u] = low[u] = timer++;
+            st.push_back(u);
+        };
+        auto edge = [&](int u, int v) {
+            if (tin[v] == -1) return true;
+            if (comp_id[v] == -1) low[u] = min(low[u], tin[v]);
+            return false;
+        };
+        auto exit = [&](int u, int p) {
+            if (low[u] == tin[u]) {
+                comp.emplace_back();
+                int x;
+                do {
+                    x = st.back(); st.pop_back();
+                    comp_id[x] = idx;
+                    comp.back().push_back(x);
+                } while (x != u);
+                idx++;
+            }
+            if (p != -1) low[p] = min(low[p], low[u]);
+        };
+        for (int i = 0; i < n; i++) if (tin[i] == -1) dfs_iter(g, i, enter, edge, exit);
+        reverse(ALL(comp));
+        for (int& c : comp_id) c = idx - 1 - c;
     }
 };
 
-struct Dinic {
-    struct Edge { int to, rev; ll cap; };
-    int n;
-    vector<vector<Edge>> g;
-    vector<int> lvl, it;
-    Dinic(int n) : n(n), g(n), lvl(n), it(n) {}
-    void add_edge(int u, int v, ll cap) {
-        Edge a{v, (int)g[v].size(), cap};
-        Edge b{u, (int)g[u].size(), 0};
-        g[u].push_back(a);
-        g[v].push_back(b);
+template <class E>
+struct ResidualGraph {
+    using Edge = E;
+    int n, src = -1;
+    vector<Edge> e;
+    vector<ll> off;
+    vector<int> where;
+    bool dirty = false;
+    ResidualGraph(int n) : n(n), off(n + 1, 0) {}
+    int add_arcs(int u, int v, Edge a, Edge b) {
+        int id = SZ(where), k = SZ(e);
+        a.to = v; a.rev = k + 1;
+        b.to = u; b.rev = k;
+        e.push_back(a);
+        e.push_back(b);
+        where.push_back(k);
+        where.push_back(k + 1);
+        dirty = true;
+        return id;
+    }
+    Edge& arc(int id) { return e[where[id]]; }
+    ll flow(int id) const { return e[e[where[id]].rev].cap; }
+    void build() {
+        off.assign(n + 1, 0);
+        for (auto& x : e) off[e[x.rev].to + 1]++;
+        REP(u, n) off[u + 1] += off[u];
+        vector<ll> pos(off.begin(), off.end() - 1);
+        vector<int> perm(SZ(e));
+        REP(i, SZ(e)) perm[i] = int(pos[e[e[i].rev].to]++);
+        vector<Edge> ne(SZ(e));
+        REP(i, SZ(e)) {
+            ne[perm[i]] = e[i];
+            ne[perm[i]].rev = perm[e[i].rev];
+        }
+        e.swap(ne);
+        for (int& w : where) w = perm[w];
+        dirty = false;
     }
+    vector<char> min_cut() const {
+        vector<char> side(n, 0);
+        if (src < 0) return side;
+        vector<int> q{src};
+        side[src] = 1;
+        REP(k, SZ(q)) {
+            int v = q[k];
+            for (ll i = off[v]; i < off[v + 1]; i++) {
+                const Edge& a = e[i];
+                if (a.cap > 0 && !side[a.to]) {
+                    side[a.to] = 1;
+                    q.push_back(a.to);
+                }
+            }
+        }
+        return side;
+    }
+};
+
+struct FlowEdge { int to, rev; ll cap; };
+
+struct FlowGraph : ResidualGraph<FlowEdge> {
+    using ResidualGraph::ResidualGraph;
+    FlowGraph(const CSRGraph& g) : ResidualGraph(g.n) {
+        e.reserve(2 * g.edges());
+        where.reserve(2 * g.edges());
+        REP(u, n) for (ll i = g.off[u]; i < g.off[u + 1]; i++) add_edge(u, g.to[i], g.weight(i));
+    }
+    int add_edge(int u, int v, ll cap) { return add_arcs(u, v, {0, 0, cap}, {0, 0, 0}); }
+};
+
+struct Dinic : FlowGraph {
+    vector<int> lvl;
+    vector<ll> it;
+    vector<int> path;
+    using FlowGraph::FlowGraph;
     bool bfs(int s, int t) {
         fill(ALL(lvl), -1);
-        queue<int> q;
-        lvl[s] = 0; q.push(s);
-        while (!q.empty()) {
-            int v = q.front(); q.pop();
-            for (auto& e : g[v]) if (e.cap > 0 && lvl[e.to] == -1) {
-                lvl[e.to] = lvl[v] + 1;
-                q.push(e.to);
+        vector<int> q{s};
+        lvl[s] = 0;
+        REP(k, SZ(q)) {
+            int v = q[k];
+            for (ll i = off[v]; i < off[v + 1]; i++) {
+                const Edge& x = e[i];
+                if (x.cap > 0 && lvl[x.to] == -1) {
+                    lvl[x.to] = lvl[v] + 1;
+                    q.push_back(x.to);
+                }
             }
         }
         return lvl[t] != -1;
     }
-    ll dfs(int v, int t, ll f) {
-        if (v == t || f == 0) return f;
-        for (int& i = it[v]; i < (int)g[v].size(); i++) {
-            Edge& e = g[v][i];
-            if (e.cap > 0 && lvl[e.to] == lvl[v] + 1) {
-                ll ret = dfs(e.to, t, min(f, e.cap));
-                if (ret) {
-                    e.cap -= ret;
-                    g[e.to][e.rev].cap += ret;
-                    return ret;
+    ll blocking_flow(int s, int t) {
+        ll flow = 0;
+        path.clear();
+        int v = s;
+        while (true) {
+            if (v == t) {
+                ll f = INF64;
+                for (int id : path) f = min(f, e[id].cap);
+                int cut = -1;
+                REP(k, SZ(path)) {
+                    Edge& a = e[path[k]];
+                    a.cap -= f;
+                    e[a.rev].cap += f;
+                    if (cut < 0 && a.cap == 0) cut = k;
                 }
+                flow += f;
+                path.resize(cut);
+                v = path.empty() ? s : e[path.back()].to;
+                continue;
             }
+            ll& i = it[v];
+            while (i < off[v + 1] && !(e[i].cap > 0 && lvl[e[i].to] == lvl[v] + 1)) i++;
+            if (i < off[v + 1]) {
+                path.push_back(int(i));
+                v = e[i].to;
+                continue;
+            }
+            if (v == s) break;
+            lvl[v] = -1;
+            path.pop_back();
+            v = path.empty() ? s : e[path.back()].to;
         }
-        return 0;
+        return flow;
     }
     ll max_flow(int s, int t) {
-        ll flow = 0, pushed;
+        if (dirty) build();
+        src = s;
+        lvl.assign(n, -1);
+        it.assign(n, 0);
+        ll flow = 0;
+        if (s == t) return 0;
         while (bfs(s, t)) {
-            fill(ALL(it), 0);
-            while ((pushed = dfs(s, t, INF64))) flow += pushed;
+            copy(off.begin(), off.end() - 1, it.begin());
+            flow += blocking_flow(s, t);
         }
         return flow;
     }
 };
 
+struct HLPP : FlowGraph {
+    vector<ll> ex, cur;
+    vector<int> h, nxt, prv, head, act, anext;
+    int hi = 0, top = 0, lim = 0;
+    using FlowGraph::FlowGraph;
+    void link(int v) {
+        int k = h[v];
+        if (k >= n) return;
+        prv[v] = -1;
+        nxt[v] = head[k];
+        if (head[k] >= 0) prv[head[k]] = v;
+        head[k] = v;
+        top = max(top, k);
+    }
+    void unlink(int v) {
+        int k = h[v];
+        if (k >= n) return;
+        if (prv[v] >= 0) nxt[prv[v]] = nxt[v];
+        else head[k] = nxt[v];
+        if (nxt[v] >= 0) prv[nxt[v]] = prv[v];
+    }
+    void activate(int v) {
+        if (h[v] >= lim) return;
+        anext[v] = act[h[v]];
+        act[h[v]] = v;
+        hi = max(hi, h[v]);
+    }
+    void push(ll id, ll f, int s, int t) {
+        Edge& a = e[id];
+        int v = a.to;
+        if (!ex[v] && v != s && v != t) activate(v);
+        a.cap -= f;
+        e[a.rev].cap += f;
+        ex[v] += f;
+        ex[e[a.rev].to] -= f;
+    }
+    void gap(int g) {
+        FOR(k, g + 1, top) {
+            for (int v = head[k]; v >= 0; v = nxt[v]) h[v] = n + 1;
+            head[k] = act[k] = -1;
+        }
+        top = g - 1;
+    }
+    void bfs_label(int root, int base, vector<int>& q) {
+        h[root] = base;
+        q.assign(1, root);
+        REP(k, SZ(q)) {
+            int v = q[k];
+            for (ll i = off[v]; i < off[v + 1]; i++) {
+                const Edge& a = e[i];
+                if (e[a.rev].cap > 0 && h[a.to] == 2 * n) {
+                    h[a.to] = h[v] + 1;
+                    q.push_back(a.to);
+                }
+            }
+        }
+    }
+    void global_relabel(int s, int t) {
+        vector<int> q;
+        fill(ALL(h), 2 * n);
+        h[s] = n;
+        bfs_label(t, 0, q);
+        bfs_label(s, n, q);
+        fill(ALL(head), -1);
+        fill(ALL(act), -1);
+        hi = top = 0;
+        REP(v, n) {
+            cur[v] = off[v];
+            link(v);
+            if (ex[v] > 0 && v != s && v != t) activate(v);
+        }
+    }
+    void discharge(int s, int t) {
+        global_relabel(s, t);
+        ll work = 0, limit = 6LL * n + SZ(e) / 2;
+        while (true) {
+            while (hi >= 0 && act[hi] < 0) hi--;
+            if (hi < 0) break;
+            int u = act[hi];
+            act[hi] = anext[u];
+            if (h[u] != hi || ex[u] <= 0) continue;
+            while (ex[u] > 0) {
+                if (cur[u] == off[u + 1]) {
+                    int old = h[u], nh = 2 * n;
+                    for (ll i = off[u]; i < off[u + 1]; i++) {
+                        const Edge& a = e[i];
+                        if (a.cap > 0 && h[a.to] + 1 < nh) {
+                            nh = h[a.to] + 1;
+                            cur[u] = i;
+                        }
+                    }
+                    work += off[u + 1] - off[u] + 12;
+                    unlink(u);
+                    if (old < n && head[old] < 0) {
+                        gap(old);
+                        h[u] = n + 1;
+                        cur[u] = off[u];
+                    } else {
+                        h[u] = nh;
+                        link(u);
+                    }
+                    if (h[u] >= lim) break;
+                    hi = h[u];
+                } else {
+                    const Edge& a = e[cur[u]];
+                    if (a.cap > 0 && h[u] == h[a.to] + 1) push(cur[u], min(ex[u], a.cap), s, t);
+                    else cur[u]++;
+                }
+            }
+            if (work > limit) {
+                work = 0;
+                global_relabel(s, t);
+            }
+        }
+    }
+    ll max_flow(int s, int t) {
+        if (dirty) build();
+        src = s;
+        if (s == t) return 0;
+        ex.assign(n, 0);
+        h.assign(n, 0);
+        cur.assign(n, 0);
+        nxt.assign(n, -1);
+        prv.assign(n, -1);
+        anext.assign(n, -1);
+        head.assign(n, -1);
+        act.assign(2 * n, -1);
+        h[s] = n;
+        lim = n;
+        for (ll i = off[s]; i < off[s + 1]; i++) if (e[i].cap > 0) push(i, e[i].cap, s, t);
+        discharge(s, t);
+        lim = 2 * n;
+        discharge(s, t);
+        return ex[t];
+    }
+};
+
+struct CostEdge { int to, rev; ll cap, cost; };
+
+struct MinCostFlow : ResidualGraph<CostEdge> {
+    vector<ll> pot, dist, it;
+    vector<int> lvl, path;
+    using ResidualGraph::ResidualGraph;
+    int add_edge(int u, int v, ll cap, ll cost) { return add_arcs(u, v, {0, 0, cap, cost}, {0, 0, 0, -cost}); }
+    ll reduced(ll i, int u) const { return e[i].cost + pot[u] - pot[e[i].to]; }
+    void init_potential(int s) {
+        pot.assign(n, 0);
+        bool neg = false;
+        for (auto& a : e) if (a.cap > 0 && a.cost < 0) neg = true;
+        if (!neg) return;
+        vector<ll> d(n, INF64);
+        vector<char> inq(n, 0);
+        deque<int> q{s};
+        d[s] = 0;
+        while (!q.empty()) {
+            int u = q.front(); q.pop_front();
+            inq[u] = 0;
+            for (ll i = off[u]; i < off[u + 1]; i++) {
+                const Edge& a = e[i];
+                if (a.cap > 0 && d[a.to] > d[u] + a.cost) {
+                    d[a.to] = d[u] + a.cost;
+                    if (!inq[a.to]) {
+                        inq[a.to] = 1;
+                        q.push_back(a.to);
+                    }
+                }
+            }
+        }
+        REP(v, n) if (d[v] < INF64) pot[v] = d[v];
+    }
+    bool shortest(int s, int t) {
+        dist.assign(n, INF64);
+        DaryHeap<4> pq(n);
+        dist[s] = 0;
+        pq.push(0, s);
+        while (!pq.empty()) {
+            auto [d, u] = pq.pop();
+            for (ll i = off[u]; i < off[u + 1]; i++) {
+                if (e[i].cap <= 0) continue;
+                ll nd = d + reduced(i, u);
+                if (nd < dist[e[i].to]) {
+                    dist[e[i].to] = nd;
+                    pq.push(nd, e[i].to);
+                }
+            }
+        }
+        if (dist[t] == INF64) return false;
+        REP(v, n) pot[v] += min(dist[v], dist[t]);
+        return true;
+    }
+    pair<ll, ll> augment(int s, int t, ll limit) {
+        lvl.assign(n, -1);
+        vector<int> q{s};
+        lvl[s] = 0;
+        REP(k, SZ(q)) {
+            int v = q[k];
+            for (ll i = off[v]; i < off[v + 1]; i++) {
+                if (e[i].cap > 0 && reduced(i, v) == 0 && lvl[e[i].to] == -1) {
+                    lvl[e[i].to] = lvl[v] + 1;
+                    q.push_back(e[i].to);
+                }
+            }
+        }
+        it.assign(off.begin(), off.end() - 1);
+        ll flow = 0, cost = 0;
+        path.clear();
+        int v = s;
+        while (flow < limit) {
+            if (v == t) {
+                ll f = limit - flow, c = 0;
+                for (int id : path) f = min(f, e[id].cap);
+                int cut = -1;
+                REP(k, SZ(path)) {
+                    Edge& a = e[path[k]];
+                    a.cap -= f;
+                    e[a.rev].cap += f;
+                    c += a.cost;
+                    if (cut < 0 && a.cap == 0) cut = k;
+                }
+                flow += f;
+                cost += f * c;
+                path.resize(max(cut, 0));
+                v = path.empty() ? s : e[path.back()].to;
+                continue;
+            }
+            ll& i = it[v];
+            while (i < off[v + 1] && !(e[i].cap > 0 && lvl[e[i].to] == lvl[v] + 1 && reduced(i, v) == 0)) i++;
+            if (i < off[v + 1]) {
+                path.push_back(int(i));
+                v = e[i].to;
+                continue;
+            }
+            if (v == s) break;
+            lvl[v] = -1;
+            path.pop_back();
+            v = path.empty() ? s : e[path.back()].to;
+        }
+        return {flow, cost};
+    }
+    pair<ll, ll> min_cost_flow(int s, int t, ll limit = INF64) {
+        if (dirty) build();
+        src = s;
+        ll flow = 0, cost = 0;
+        if (s == t) return {0, 0};
+        init_potential(s);
+        while (flow < limit && shortest(s, t)) {
+            auto [f, c] = augment(s, t, limit - flow);
+            flow += f;
+            cost += c;
+        }
+        return {flow, cost};
+    }
+    pair<ll, ll> min_cost_max_flow_scaling(int s, int t) {
+        if (dirty) build();
+        src = s;
+        if (s == t) return {0, 0};
+        HLPP mf(n);
+        REP(id, SZ(where)) if (!(id & 1)) mf.add_edge(arc(id + 1).to, arc(id).to, arc(id).cap);
+        ll total = mf.max_flow(s, t);
+        REP(id, SZ(where)) arc(id).cap = mf.arc(id).cap;
+        const ll scale = n + 1;
+        ll eps = 0;
+        for (auto& a : e) eps = max(eps, abs(a.cost) * scale);
+        pot.assign(n, 0);
+        vector<ll> ex(n, 0);
+        it.assign(n, 0);
+        auto rc = [&](ll i, int u) { return e[i].cost * scale + pot[u] - pot[e[i].to]; };
+        auto push = [&](ll i, int u, ll f) {
+            e[i].cap -= f;
+            e[e[i].rev].cap += f;
+            ex[u] -= f;
+            ex[e[i].to] += f;
+        };
+        while (eps > 1) {
+            eps = max(1LL, eps / 16);
+            REP(u, n) for (ll i = off[u]; i < off[u + 1]; i++) if (e[i].cap > 0 && rc(i, u) < 0) push(i, u, e[i].cap);
+            deque<int> q;
+            REP(u, n) {
+                it[u] = off[u];
+                if (ex[u] > 0) q.push_back(u);
+            }
+            while (!q.empty()) {
+                int u = q.front(); q.pop_front();
+                while (ex[u] > 0) {
+                    if (it[u] == off[u + 1]) {
+                        ll best = -INF64 * 4;
+                        for (ll i = off[u]; i < off[u + 1]; i++) if (e[i].cap > 0) best = max(best, pot[e[i].to] - e[i].cost * scale);
+                        pot[u] = best - eps;
+                        it[u] = off[u];
+                        continue;
+                    }
+                    ll i = it[u];
+                    if (e[i].cap > 0 && rc(i, u) < 0) {
+                        int v = e[i].to;
+                        bool was = ex[v] > 0;
+                        push(i, u, min(ex[u], e[i].cap));
+                        if (!was && ex[v] > 0) q.push_back(v);
+                    } else it[u]++;
+                }
+            }
+        }
+        ll cost = 0;
+        REP(id, SZ(where)) if (!(id & 1)) cost += flow(id) * arc(id).cost;
+        return {total, cost};
+    }
+};
+
 #endif
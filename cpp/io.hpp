@@ -0,0 +1,188 @@
+#ifndef CP_IO_HPP
+#define CP_IO_HPP
+
+#include "base.hpp"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define CP_IO_MMAP 1
+#endif
+
+struct FastInput {
+    const char* p = nullptr;
+    const char* end = nullptr;
+    void* mapped = nullptr;
+    size_t mapped_len = 0;
+    vector<char> store;
+    FastInput(FILE* f = stdin) { init(f); }
+    FastInput(const char* path) {
+        FILE* f = fopen(path, "rb");
+        if (!f) throw runtime_error(string("FastInput: cannot open ") + path);
+        init(f);
+        fclose(f);
+    }
+    FastInput(const FastInput&) = delete;
+    FastInput& operator=(const FastInput&) = delete;
+    ~FastInput() {
+#ifdef CP_IO_MMAP
+        if (mapped) munmap(mapped, mapped_len);
+#endif
+    }
+    void init(FILE* f) {
+#ifdef CP_IO_MMAP
+        struct stat sb;
+        int fd = fileno(f);
+        if (fstat(fd, &sb) == 0 && S_ISREG(sb.st_mode) && sb.st_size > 0 && lseek(fd, 0, SEEK_CUR) == 0) {
+            void* m = mmap(nullptr, (size_t)sb.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (m != MAP_FAILED) {
+                mapped = m;
+                mapped_len = (size_t)sb.st_size;
+                p = (const char*)m;
+                end = p + mapped_len;
+                return;
+            }
+        }
+#endif
+        size_t len = 0;
+        store.resize(1 << 16);
+        while (true) {
+            size_t got = fread(store.data() + len, 1, store.size() - len, f);
+            len += got;
+            if (len < store.size()) break;
+            store.resize(store.size() * 2);
+        }
+        store.resize(len);
+        p = store.data();
+        end = p + len;
+    }
+    bool skip() {
+        while (p < end && (unsigned char)*p <= ' ') ++p;
+        return p < end;
+    }
+    bool eof() { return !skip(); }
+    template <class T>
+    T read() {
+        static_assert(is_integral<T>::value, "FastInput::read needs an integral type");
+        using U = make_unsigned_t<T>;
+        skip();
+        bool neg = false;
+        if (p < end && (*p == '-' || *p == '+')) neg = *p++ == '-';
+        U x = 0;
+        while (p < end && (unsigned)(*p - '0') < 10) x = x * 10 + (U)(*p++ - '0');
+        return neg ? (T)(U(0) - x) : (T)x;
+    }
+    int next_int() { return read<int>(); }
+    ll next_ll() { return read<ll>(); }
+    ull next_ull() { return read<ull>(); }
+    char next_char() {
+        skip();
+        return p < end ? *p++ : '\0';
+    }
+    double next_double() {
+        skip();
+        const char* s = p;
+        while (p < end && ((unsigned)(*p - '0') < 10 || (*p && strchr("+-.eE", *p)))) ++p;
+        char buf[64];
+        size_t len = p - s;
+        if (len < sizeof buf) {
+            memcpy(buf, s, len);
+            buf[len] = '\0';
+            return strtod(buf, nullptr);
+        }
+        return strtod(string(s, len).c_str(), nullptr);
+    }
+    string_view token() {
+        skip();
+        const char* s = p;
+        while (p < end && (unsigned char)*p > ' ') ++p;
+        return string_view(s, p - s);
+    }
+    string_view line() {
+        const char* s = p;
+        while (p < end && *p != '\n') ++p;
+        const char* e = p;
+        if (p < end) ++p;
+        if (e > s && e[-1] == '\r') --e;
+        return string_view(s, e - s);
+    }
+    template <class T, enable_if_t<is_integral<T>::value && !is_same<T, bool>::value, int> = 0>
+    FastInput& operator>>(T& x) { x = read<T>(); return *this; }
+    FastInput& operator>>(bool& b) { b = read<ll>() != 0; return *this; }
+    FastInput& operator>>(char& c) { c = next_char(); return *this; }
+    FastInput& operator>>(double& x) { x = next_double(); return *this; }
+    FastInput& operator>>(string_view& s) { s = token(); return *this; }
+    FastInput& operator>>(string& s) { s.assign(token()); return *this; }
+};
+
+struct FastOutput {
+    FILE* f;
+    vector<char> buf;
+    size_t pos = 0;
+    int precision = 10;
+    FastOutput(FILE* f = stdout, size_t cap = 1 << 22) : f(f), buf(cap) {}
+    FastOutput(const FastOutput&) = delete;
+    FastOutput& operator=(const FastOutput&) = delete;
+    ~FastOutput() { flush(); }
+    void flush() {
+        if (pos) fwrite(buf.data(), 1, pos, f);
+        pos = 0;
+        fflush(f);
+    }
+    void reserve(size_t k) {
+        if (pos + k > buf.size()) {
+            fwrite(buf.data(), 1, pos, f);
+            pos = 0;
+        }
+    }
+    void put(char c) {
+        reserve(1);
+        buf[pos++] = c;
+    }
+    void write(string_view s) {
+        if (s.size() > buf.size()) {
+            reserve(buf.size());
+            fwrite(s.data(), 1, s.size(), f);
+            return;
+        }
+        reserve(s.size());
+        memcpy(buf.data() + pos, s.data(), s.size());
+        pos += s.size();
+    }
+    template <class T>
+    void write_int(T x) {
+        static_assert(is_integral<T>::value, "FastOutput::write_int needs an integral type");
+        using U = make_unsigned_t<T>;
+        reserve(24);
+        U u = (U)x;
+        if (x < 0) {
+            buf[pos++] = '-';
+            u = U(0) - u;
+        }
+        char tmp[24];
+        int k = 0;
+        do { tmp[k++] = char('0' + u % 10); u /= 10; } while (u);
+        while (k) buf[pos++] = tmp[--k];
+    }
+    void write_double(double x) {
+        reserve(64);
+        int k = snprintf(buf.data() + pos, 64, "%.*f", precision, x);
+        if (k >= 64) {
+            string s(k + 1, '\0');
+            snprintf(s.data(), s.size(), "%.*f", precision, x);
+            s.pop_back();
+            write(s);
+        } else pos += k;
+    }
+    template <class T, enable_if_t<is_integral<T>::value, int> = 0>
+    FastOutput& operator<<(T x) { write_int(x); return *this; }
+    FastOutput& operator<<(char c) { put(c); return *this; }
+    FastOutput& operator<<(bool b) { put(char('0' + b)); return *this; }
+    FastOutput& operator<<(double x) { write_double(x); return *this; }
+    FastOutput& operator<<(const char* s) { write(s); return *this; }
+    FastOutput& operator<<(string_view s) { write(s); return *this; }
+    FastOutput& operator<<(const string& s) { write(s); return *this; }
+};
+
+#endif
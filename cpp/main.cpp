@@ -1,6 +1,7 @@
 #include "all.hpp"
 
 int main() {
-    FAST_IO;
+    FastInput in;
+    FastOutput out;
     return 0;
 }
@@ -3,7 +3,62 @@
 
 #include "base.hpp"
 
+struct Barrett {
+    uint32_t m;
+    ull im;
+    explicit Barrett(uint32_t m = 1) : m(m), im(~0ULL / m + 1) {}
+    uint32_t reduce(ull z) const {
+        ull x = (ull)(((unsigned __int128)z * im) >> 64);
+        ull y = x * m;
+        return (uint32_t)(z < y ? z - y + m : z - y);
+    }
+    uint32_t mul(uint32_t a, uint32_t b) const { return reduce((ull)a * b); }
+    uint32_t pow(uint32_t a, ull e) const {
+        uint32_t res = 1 % m;
+        while (e) {
+            if (e & 1) res = mul(res, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return res;
+    }
+};
+
+struct Montgomery64 {
+    ull mod, inv, r1, r2;
+    explicit Montgomery64(ull mod) : mod(mod), inv(mod) {
+        for (int i = 0; i < 5; i++) inv *= 2 - mod * inv;
+        r1 = -mod % mod;
+        r2 = (unsigned __int128)r1 * r1 % mod;
+    }
+    ull reduce(unsigned __int128 t) const {
+        ull q = (ull)t * inv;
+        ull h = (ull)(((unsigned __int128)q * mod) >> 64);
+        ull hi = (ull)(t >> 64);
+        return hi < h ? hi - h + mod : hi - h;
+    }
+    ull to(ull x) const { return reduce((unsigned __int128)(x % mod) * r2); }
+    ull from(ull x) const { return reduce(x); }
+    ull mul(ull a, ull b) const { return reduce((unsigned __int128)a * b); }
+    ull pow(ull a, ull e) const {
+        ull res = r1;
+        while (e) {
+            if (e & 1) res = mul(res, a);
+            a = mul(a, a);
+            e >>= 1;
+        }
+        return res;
+    }
+};
+
 inline ll mod_pow(ll a, ll e, ll mod) {
+    a %= mod;
+    if (a < 0) a += mod;
+    if (mod <= UINT32_MAX) return Barrett((uint32_t)mod).pow((uint32_t)a, e);
+    if (mod & 1) {
+        Montgomery64 mg(mod);
+        return mg.from(mg.pow(mg.to(a), e));
+    }
     ll res = 1 % mod;
     while (e) {
         if (e & 1) res = (__int128)res * a % mod;
@@ -24,16 +79,19 @@ inline ll lcm_ll(ll a, ll b) {
 struct Comb {
     int n;
     ll mod;
+    bool small;
+    Barrett bt;
     vector<ll> fact, ifact;
-    Comb(int n, ll mod) : n(n), mod(mod), fact(n + 1), ifact(n + 1) {
-        fact[0] = 1;
-        FOR(i, 1, n) fact[i] = fact[i - 1] * i % mod;
+    Comb(int n, ll mod) : n(n), mod(mod), small(mod <= UINT32_MAX), bt(small ? (uint32_t)mod : 1), fact(n + 1), ifact(n + 1) {
+        fact[0] = 1 % mod;
+        FOR(i, 1, n) fact[i] = mul(fact[i - 1], i);
         ifact[n] = mod_inv(fact[n], mod);
-        FORD(i, n, 1) ifact[i - 1] = ifact[i] * i % mod;
+        FORD(i, n, 1) ifact[i - 1] = mul(ifact[i], i);
     }
+    ll mul(ll a, ll b) const { return small ? bt.reduce((ull)a * b) : (ll)((unsigned __int128)a * b % mod); }
     ll nCr(int nn, int r) const {
         if (r < 0 || r > nn) return 0;
-        return fact[nn] * ifact[r] % mod * ifact[nn - r] % mod;
+        return mul(mul(fact[nn], ifact[r]), ifact[nn - r]);
     }
 };
 
@@ -67,11 +125,68 @@ struct LinearSieve {
     }
 };
 
+struct SegmentedSieve {
+    static constexpr int SEG_BITS = 1 << 18;
+    ull limit;
+    vector<int> base;
+    SegmentedSieve(ull limit) : limit(limit) {
+        ull s = (ull)sqrtl((long double)limit);
+        while (s * s > limit) --s;
+        while ((s + 1) * (s + 1) <= limit) ++s;
+        base = LinearSieve((int)s).primes;
+        if (!base.empty()) base.erase(base.begin());
+    }
+    template <class G>
+    void segments(ull L, ull R, G g) const {
+        R = min(R, limit);
+        ull lo = max<ull>(L, 3) | 1;
+        if (lo > R) return;
+        vector<ull> bits(SEG_BITS / 64), nxt(SZ(base));
+        int np = 0;
+        for (ull s = lo; s <= R; s += 2ULL * SEG_BITS) {
+            ull e = min(R, s + 2ULL * (SEG_BITS - 1));
+            int nb = (int)((e - s) / 2 + 1);
+            fill(bits.begin(), bits.begin() + (nb + 63) / 64, ~0ULL);
+            while (np < SZ(base) && (ull)base[np] * base[np] <= e) {
+                ull p = base[np];
+                ull m = max(p * p, (s + p - 1) / p * p);
+                if (!(m & 1)) m += p;
+                nxt[np++] = m;
+            }
+            REP(i, np) {
+                ull p2 = 2ULL * base[i], m = nxt[i];
+                for (; m <= e; m += p2) bits[(m - s) >> 7] &= ~(1ULL << (((m - s) >> 1) & 63));
+                nxt[i] = m;
+            }
+            if (nb & 63) bits[nb >> 6] &= (1ULL << (nb & 63)) - 1;
+            g(bits.data(), (nb + 63) / 64, s);
+        }
+    }
+    template <class F>
+    void for_each(ull L, ull R, F f) const {
+        if (L <= 2 && 2 <= min(R, limit)) f(2ULL);
+        segments(L, R, [&](const ull* bits, int nw, ull s) {
+            REP(w, nw) for (ull x = bits[w]; x; x &= x - 1) f(s + 2 * (64ULL * w + __builtin_ctzll(x)));
+        });
+    }
+    ull count(ull L, ull R) const {
+        ull res = L <= 2 && 2 <= min(R, limit);
+        segments(L, R, [&](const ull* bits, int nw, ull) {
+            REP(w, nw) res += __builtin_popcountll(bits[w]);
+        });
+        return res;
+    }
+};
+
 inline ull mod_mul64(ull a, ull b, ull mod) {
-    return (__int128)a * b % mod;
+    return (unsigned __int128)a * b % mod;
 }
 
 inline ull mod_pow64(ull a, ull e, ull mod) {
+    if (mod & 1) {
+        Montgomery64 mg(mod);
+        return mg.from(mg.pow(mg.to(a), e));
+    }
     ull res = 1 % mod;
     while (e) {
         if (e & 1) res = mod_mul64(res, a, mod);
@@ -82,7 +197,15 @@ inline ull mod_pow64(ull a, ull e, ull mod) {
 }
 
 inline ull gcd_u64(ull a, ull b) {
-    return b == 0 ? a : gcd_u64(b, a % b);
+    if (!a || !b) return a | b;
+    int sh = __builtin_ctzll(a | b);
+    a >>= __builtin_ctzll(a);
+    while (b) {
+        b >>= __builtin_ctzll(b);
+        if (a > b) swap(a, b);
+        b -= a;
+    }
+    return a << sh;
 }
 
 inline bool is_probable_prime(ull n) {
@@ -92,13 +215,14 @@ inline bool is_probable_prime(ull n) {
     }
     ull d = n - 1, s = 0;
     while ((d & 1) == 0) { d >>= 1; ++s; }
+    Montgomery64 mg(n);
+    ull one = mg.r1, neg = mg.to(n - 1);
     auto witness = [&](ull a) {
-        if (a % n == 0) return true;
-        ull x = mod_pow64(a, d, n);
-        if (x == 1 || x == n - 1) return true;
+        ull x = mg.pow(mg.to(a), d);
+        if (x == one || x == neg) return true;
         for (ull r = 1; r < s; r++) {
-            x = mod_mul64(x, x, n);
-            if (x == n - 1) return true;
+            x = mg.mul(x, x);
+            if (x == neg) return true;
         }
         return false;
     };
@@ -109,36 +233,125 @@ inline bool is_probable_prime(ull n) {
     return true;
 }
 
-inline mt19937_64 pollard_rng((uint64_t)chrono::steady_clock::now().time_since_epoch().count());
-
-inline ull pollard_f(ull x, ull c, ull mod) {
-    return (mod_mul64(x, x, mod) + c) % mod;
-}
+inline thread_local mt19937_64 pollard_rng((uint64_t)chrono::steady_clock::now().time_since_epoch().count() ^ hash<thread::id>()(this_thread::get_id()));
 
 inline ull pollard_rho(ull n) {
     if ((n & 1) == 0) return 2;
     if (n % 3 == 0) return 3;
+    const ull M = 128;
+    Montgomery64 mg(n);
     while (true) {
-        ull c = uniform_int_distribution<ull>(1, n - 1)(pollard_rng);
-        ull x = uniform_int_distribution<ull>(0, n - 1)(pollard_rng);
-        ull y = x;
-        ull d = 1;
-        while (d == 1) {
-            x = pollard_f(x, c, n);
-            y = pollard_f(pollard_f(y, c, n), c, n);
-            ull diff = x > y ? x - y : y - x;
-            d = gcd_u64(diff, n);
+        ull c = mg.to(uniform_int_distribution<ull>(1, n - 1)(pollard_rng));
+        ull y = mg.to(uniform_int_distribution<ull>(0, n - 1)(pollard_rng));
+        auto f = [&](ull v) {
+            v = mg.mul(v, v);
+            return v >= n - c ? v - (n - c) : v + c;
+        };
+        ull x = y, ys = y, q = mg.r1, g = 1;
+        for (ull r = 1; g == 1; r <<= 1) {
+            x = y;
+            for (ull i = 0; i < r; i++) y = f(y);
+            for (ull k = 0; k < r && g == 1; k += M) {
+                ys = y;
+                for (ull i = 0; i < M && i < r - k; i++) {
+                    y = f(y);
+                    q = mg.mul(q, x > y ? x - y : y - x);
+                }
+                g = gcd_u64(q, n);
+            }
         }
-        if (d != n) return d;
+        if (g == n) {
+            do {
+                ys = f(ys);
+                g = gcd_u64(x > ys ? x - ys : ys - x, n);
+            } while (g == 1);
+        }
+        if (g != n) return g;
     }
 }
 
+struct TrialDivisor {
+    ull p, inv, lim;
+};
+
+inline const vector<TrialDivisor>& trial_divisors() {
+    static const vector<TrialDivisor> table = [] {
+        vector<TrialDivisor> t;
+        for (int p : LinearSieve(1000).primes) if (p > 2) {
+            ull inv = p;
+            for (int i = 0; i < 5; i++) inv *= 2 - p * inv;
+            t.push_back({(ull)p, inv, ~0ULL / p});
+        }
+        return t;
+    }();
+    return table;
+}
+
+inline int factor_into(ull n, ull* out) {
+    int k = 0;
+    if (n <= 1) return 0;
+    int tz = __builtin_ctzll(n);
+    n >>= tz;
+    while (tz--) out[k++] = 2;
+    for (const auto& t : trial_divisors()) {
+        if (t.p * t.p > n) break;
+        while (n * t.inv <= t.lim) {
+            out[k++] = t.p;
+            n *= t.inv;
+        }
+    }
+    if (n > 1) {
+        ull st[64];
+        int sp = 0;
+        st[sp++] = n;
+        while (sp) {
+            ull m = st[--sp];
+            if (m < 1'000'000 || is_probable_prime(m)) { out[k++] = m; continue; }
+            ull d = pollard_rho(m);
+            st[sp++] = d;
+            st[sp++] = m / d;
+        }
+    }
+    sort(out, out + k);
+    return k;
+}
+
 inline void factor_rec(ull n, map<ull, int>& res) {
-    if (n == 1) return;
-    if (is_probable_prime(n)) { res[n]++; return; }
-    ull d = pollard_rho(n);
-    factor_rec(d, res);
-    factor_rec(n / d, res);
+    ull buf[64];
+    int k = factor_into(n, buf);
+    REP(i, k) res[buf[i]]++;
+}
+
+struct FactorTable {
+    vector<int> start;
+    vector<ull> primes;
+    int size() const { return SZ(start) - 1; }
+    const ull* begin(int i) const { return primes.data() + start[i]; }
+    const ull* end(int i) const { return primes.data() + start[i + 1]; }
+};
+
+inline FactorTable factor_many(const vector<ull>& xs, int threads = 1) {
+    int n = SZ(xs);
+    threads = max(1, min(thread_count(threads), n));
+    vector<vector<ull>> part(threads);
+    vector<vector<int>> cnt(threads);
+    parallel_for(n, threads, [&](ll lo, ll hi, int t) {
+        ull buf[64];
+        cnt[t].resize(hi - lo);
+        for (ll i = lo; i < hi; i++) {
+            int k = factor_into(xs[i], buf);
+            cnt[t][i - lo] = k;
+            part[t].insert(part[t].end(), buf, buf + k);
+        }
+    });
+    FactorTable res;
+    res.start.reserve(n + 1);
+    res.start.push_back(0);
+    REP(t, threads) {
+        for (int c : cnt[t]) res.start.push_back(res.start.back() + c);
+        res.primes.insert(res.primes.end(), ALL(part[t]));
+    }
+    return res;
 }
 
 inline ll ext_gcd(ll a, ll b, ll& x, ll& y) {
@@ -173,4 +386,104 @@ inline pair<ll, ll> crt_pair(pair<ll, ll> a, pair<ll, ll> b) {
     return {res, l};
 }
 
+template <int M>
+struct static_modint {
+    using mint = static_modint;
+    uint32_t v;
+    static constexpr int mod() { return M; }
+    static_modint() : v(0) {}
+    template <class T, enable_if_t<is_signed<T>::value, int> = 0>
+    static_modint(T x) { ll y = (ll)x % M; v = (uint32_t)(y < 0 ? y + M : y); }
+    template <class T, enable_if_t<is_unsigned<T>::value, int> = 0>
+    static_modint(T x) : v((uint32_t)((ull)x % M)) {}
+    static mint raw(uint32_t x) { mint r; r.v = x; return r; }
+    int val() const { return (int)v; }
+    mint& operator+=(const mint& o) { v += o.v; if (v >= (uint32_t)M) v -= M; return *this; }
+    mint& operator-=(const mint& o) { v += M - o.v; if (v >= (uint32_t)M) v -= M; return *this; }
+    mint& operator*=(const mint& o) { v = (uint32_t)((ull)v * o.v % M); return *this; }
+    mint& operator/=(const mint& o) { return *this *= o.inv(); }
+    mint operator-() const { return raw(v ? M - v : 0); }
+    mint pow(ull e) const {
+        mint res = raw(1 % M), a = *this;
+        while (e) {
+            if (e & 1) res *= a;
+            a *= a;
+            e >>= 1;
+        }
+        return res;
+    }
+    mint inv() const { return pow(M - 2); }
+    friend mint operator+(mint a, const mint& b) { return a += b; }
+    friend mint operator-(mint a, const mint& b) { return a -= b; }
+    friend mint operator*(mint a, const mint& b) { return a *= b; }
+    friend mint operator/(mint a, const mint& b) { return a /= b; }
+    friend bool operator==(const mint& a, const mint& b) { return a.v == b.v; }
+    friend bool operator!=(const mint& a, const mint& b) { return a.v != b.v; }
+    friend ostream& operator<<(ostream& os, const mint& a) { return os << a.v; }
+};
+
+template <int id>
+struct dynamic_modint {
+    using mint = dynamic_modint;
+    uint32_t v;
+    static inline Barrett bt{(uint32_t)MOD};
+    static int mod() { return (int)bt.m; }
+    static void set_mod(int m) { bt = Barrett((uint32_t)m); }
+    dynamic_modint() : v(0) {}
+    template <class T, enable_if_t<is_signed<T>::value, int> = 0>
+    dynamic_modint(T x) { ll y = (ll)x % mod(); v = (uint32_t)(y < 0 ? y + mod() : y); }
+    template <class T, enable_if_t<is_unsigned<T>::value, int> = 0>
+    dynamic_modint(T x) : v((uint32_t)((ull)x % mod())) {}
+    static mint raw(uint32_t x) { mint r; r.v = x; return r; }
+    int val() const { return (int)v; }
+    mint& operator+=(const mint& o) { v += o.v; if (v >= bt.m) v -= bt.m; return *this; }
+    mint& operator-=(const mint& o) { v += bt.m - o.v; if (v >= bt.m) v -= bt.m; return *this; }
+    mint& operator*=(const mint& o) { v = bt.mul(v, o.v); return *this; }
+    mint& operator/=(const mint& o) { return *this *= o.inv(); }
+    mint operator-() const { return raw(v ? bt.m - v : 0); }
+    mint pow(ull e) const { return raw(bt.pow(v, e)); }
+    mint inv() const { return raw((uint32_t)mod_inv_any(v, mod())); }
+    friend mint operator+(mint a, const mint& b) { return a += b; }
+    friend mint operator-(mint a, const mint& b) { return a -= b; }
+    friend mint operator*(mint a, const mint& b) { return a *= b; }
+    friend mint operator/(mint a, const mint& b) { return a /= b; }
+    friend bool operator==(const mint& a, const mint& b) { return a.v == b.v; }
+    friend bool operator!=(const mint& a, const mint& b) { return a.v != b.v; }
+    friend ostream& operator<<(ostream& os, const mint& a) { return os << a.v; }
+};
+
+template <int id>
+struct dynamic_modint64 {
+    using mint = dynamic_modint64;
+    ull v;
+    static inline Montgomery64 mg{(ull)MOD};
+    static ll mod() { return (ll)mg.mod; }
+    static void set_mod(ll m) { mg = Montgomery64((ull)m); }
+    dynamic_modint64() : v(0) {}
+    template <class T, enable_if_t<is_signed<T>::value, int> = 0>
+    dynamic_modint64(T x) { ll y = (ll)x % mod(); v = mg.to(y < 0 ? y + mod() : y); }
+    template <class T, enable_if_t<is_unsigned<T>::value, int> = 0>
+    dynamic_modint64(T x) : v(mg.to((ull)x)) {}
+    ll val() const { return (ll)mg.from(v); }
+    mint& operator+=(const mint& o) { v += o.v; if (v >= mg.mod) v -= mg.mod; return *this; }
+    mint& operator-=(const mint& o) { v += mg.mod - o.v; if (v >= mg.mod) v -= mg.mod; return *this; }
+    mint& operator*=(const mint& o) { v = mg.mul(v, o.v); return *this; }
+    mint& operator/=(const mint& o) { return *this *= o.inv(); }
+    mint operator-() const { mint r; r.v = v ? mg.mod - v : 0; return r; }
+    mint pow(ull e) const { mint r; r.v = mg.pow(v, e); return r; }
+    mint inv() const { return mint(mod_inv_any(val(), mod())); }
+    friend mint operator+(mint a, const mint& b) { return a += b; }
+    friend mint operator-(mint a, const mint& b) { return a -= b; }
+    friend mint operator*(mint a, const mint& b) { return a *= b; }
+    friend mint operator/(mint a, const mint& b) { return a /= b; }
+    friend bool operator==(const mint& a, const mint& b) { return a.v == b.v; }
+    friend bool operator!=(const mint& a, const mint& b) { return a.v != b.v; }
+    friend ostream& operator<<(ostream& os, const mint& a) { return os << a.val(); }
+};
+
+using mint = static_modint<MOD>;
+using mint2 = static_modint<MOD2>;
+using dmint = dynamic_modint<-1>;
+using dmint64 = dynamic_modint64<-1>;
+
 #endif
@@ -0,0 +1,200 @@
+#ifndef CP_POLY_HPP
+#define CP_POLY_HPP
+
+#include "base.hpp"
+#include "math.hpp"
+
+template <int M, int G = 3>
+struct NTT {
+    using mint = static_modint<M>;
+    static inline vector<mint> rt{0, 1}, irt{0, 1};
+    static void ensure(int n) {
+        while (SZ(rt) < n) {
+            int k = SZ(rt);
+            mint w = mint(G).pow((M - 1) / (2 * k)), iw = w.inv();
+            rt.resize(2 * k);
+            irt.resize(2 * k);
+            for (int j = 0; j < k; j += 2) {
+                rt[k + j] = rt[(k + j) >> 1];
+                rt[k + j + 1] = rt[k + j] * w;
+                irt[k + j] = irt[(k + j) >> 1];
+                irt[k + j + 1] = irt[k + j] * iw;
+            }
+        }
+    }
+    static void dif(vector<mint>& a) {
+        int n = SZ(a);
+        if (n <= 1) return;
+        ensure(max(n, 4));
+        int len = n >> 1;
+        if (__builtin_ctz(n) & 1) {
+            for (int j = 0; j < len; j++) {
+                mint u = a[j], v = a[j + len];
+                a[j] = u + v;
+                a[j + len] = (u - v) * rt[len + j];
+            }
+            len >>= 1;
+        }
+        const mint I = rt[3];
+        for (; len >= 2; len >>= 2) {
+            int q = len >> 1;
+            for (int i = 0; i < n; i += 4 * q) {
+                mint* p = a.data() + i;
+                for (int j = 0; j < q; j++) {
+                    mint w1 = rt[2 * q + j], w2 = rt[q + j], w3 = w1 * w2;
+                    mint x0 = p[j], x1 = p[j + q], x2 = p[j + 2 * q], x3 = p[j + 3 * q];
+                    mint a0 = x0 + x2, a1 = x1 + x3, b0 = x0 - x2, b1 = (x1 - x3) * I;
+                    p[j] = a0 + a1;
+                    p[j + q] = (a0 - a1) * w2;
+                    p[j + 2 * q] = (b0 + b1) * w1;
+                    p[j + 3 * q] = (b0 - b1) * w3;
+                }
+            }
+        }
+    }
+    static void dit(vector<mint>& a) {
+        int n = SZ(a);
+        if (n <= 1) return;
+        ensure(max(n, 4));
+        const mint I = irt[3];
+        for (int q = 1; 4 * q <= n; q <<= 2) {
+            for (int i = 0; i < n; i += 4 * q) {
+                mint* p = a.data() + i;
+                for (int j = 0; j < q; j++) {
+                    mint w1 = irt[2 * q + j], w2 = irt[q + j], w3 = w1 * w2;
+                    mint z0 = p[j], z1 = p[j + q] * w2, z2 = p[j + 2 * q] * w1, z3 = p[j + 3 * q] * w3;
+                    mint a0 = z0 + z1, a1 = z0 - z1, b0 = z2 + z3, b1 = (z2 - z3) * I;
+                    p[j] = a0 + b0;
+                    p[j + q] = a1 + b1;
+                    p[j + 2 * q] = a0 - b0;
+                    p[j + 3 * q] = a1 - b1;
+                }
+            }
+        }
+        if (__builtin_ctz(n) & 1) {
+            int len = n >> 1;
+            for (int j = 0; j < len; j++) {
+                mint u = a[j], v = a[j + len] * irt[len + j];
+                a[j] = u + v;
+                a[j + len] = u - v;
+            }
+        }
+        mint inv_n = mint(n).inv();
+        for (auto& x : a) x *= inv_n;
+    }
+};
+
+template <class mint>
+vector<mint> convolve(vector<mint> a, vector<mint> b) {
+    int n = SZ(a), m = SZ(b);
+    if (!n || !m) return {};
+    if (min(n, m) <= 40) {
+        vector<mint> c(n + m - 1);
+        REP(i, n) REP(j, m) c[i + j] += a[i] * b[j];
+        return c;
+    }
+    int sz = 1;
+    while (sz < n + m - 1) sz <<= 1;
+    using ntt = NTT<mint::mod()>;
+    a.resize(sz);
+    b.resize(sz);
+    ntt::dif(a);
+    ntt::dif(b);
+    REP(i, sz) a[i] *= b[i];
+    ntt::dit(a);
+    a.resize(n + m - 1);
+    return a;
+}
+
+inline vector<ll> convolve_mod(const vector<ll>& a, const vector<ll>& b, ll mod) {
+    constexpr int P1 = 167'772'161, P2 = 469'762'049, P3 = 998'244'353;
+    if (a.empty() || b.empty()) return {};
+    if (SZ(a) + SZ(b) - 1 > (1 << 23)) throw invalid_argument("convolve_mod: result longer than 2^23");
+    if ((__int128)min(SZ(a), SZ(b)) * (mod - 1) * (mod - 1) >= (__int128)P1 * P2 * P3) {
+        throw invalid_argument("convolve_mod: min(n, m) * (mod - 1)^2 exceeds P1 * P2 * P3");
+    }
+    auto norm = [&](const vector<ll>& v) {
+        vector<ll> r(SZ(v));
+        REP(i, SZ(v)) r[i] = (v[i] % mod + mod) % mod;
+        return r;
+    };
+    const vector<ll> na = norm(a), nb = norm(b);
+    auto run = [&](auto tag) {
+        using mi = decltype(tag);
+        return convolve(vector<mi>(ALL(na)), vector<mi>(ALL(nb)));
+    };
+    auto c1 = run(static_modint<P1>());
+    auto c2 = run(static_modint<P2>());
+    auto c3 = run(static_modint<P3>());
+    const ll i1 = mod_inv_any(P1, P2);
+    const ll i12 = mod_inv_any((ll)P1 * P2 % P3, P3);
+    const ll m12 = (ll)P1 * P2 % mod;
+    vector<ll> res(SZ(c1));
+    REP(i, SZ(res)) {
+        ll r1 = c1[i].val(), r2 = c2[i].val(), r3 = c3[i].val();
+        ll t2 = (r2 - r1 + P2) % P2 * i1 % P2;
+        ll x12 = r1 + (ll)P1 * t2;
+        ll t3 = ((r3 - x12 % P3) % P3 + P3) % P3 * i12 % P3;
+        res[i] = (x12 % mod + (ll)mod_mul64(m12, t3, mod)) % mod;
+    }
+    return res;
+}
+
+template <class mint>
+vector<mint> poly_inv(const vector<mint>& a, int m) {
+    vector<mint> b{a[0].inv()};
+    for (int k = 1; k < m; k <<= 1) {
+        vector<mint> f(a.begin(), a.begin() + min(SZ(a), 2 * k));
+        vector<mint> t = convolve(f, b);
+        t.resize(2 * k);
+        for (auto& x : t) x = -x;
+        t[0] += 2;
+        b = convolve(b, t);
+        b.resize(2 * k);
+    }
+    b.resize(m);
+    return b;
+}
+
+template <class mint>
+vector<mint> poly_deriv(const vector<mint>& a) {
+    vector<mint> res(max(0, SZ(a) - 1));
+    REP(i, SZ(res)) res[i] = a[i + 1] * (i + 1);
+    return res;
+}
+
+template <class mint>
+vector<mint> poly_integ(const vector<mint>& a) {
+    int n = SZ(a);
+    vector<mint> inv(n + 1), res(n + 1);
+    if (n) inv[1] = 1;
+    FOR(i, 2, n) inv[i] = -inv[mint::mod() % i] * (mint::mod() / i);
+    FOR(i, 1, n) res[i] = a[i - 1] * inv[i];
+    return res;
+}
+
+template <class mint>
+vector<mint> poly_log(const vector<mint>& a, int m) {
+    vector<mint> res = convolve(poly_deriv(a), poly_inv(a, m));
+    res.resize(max(0, m - 1));
+    res = poly_integ(res);
+    res.resize(m);
+    return res;
+}
+
+template <class mint>
+vector<mint> poly_exp(const vector<mint>& a, int m) {
+    vector<mint> g{1};
+    for (int k = 1; k < m; k <<= 1) {
+        vector<mint> h = poly_log(g, 2 * k);
+        for (auto& x : h) x = -x;
+        REP(i, min(SZ(a), 2 * k)) h[i] += a[i];
+        h[0] += 1;
+        g = convolve(g, h);
+        g.resize(2 * k);
+    }
+    g.resize(m);
+    return g;
+}
+
+#endif
@@ -2,6 +2,8 @@
 #define CP_QUERIES_HPP
 
 #include "base.hpp"
+#include "ds.hpp"
+#include "graph.hpp"
 
 struct Mo {
     struct Query { int l, r, idx; };
@@ -55,10 +57,16 @@ struct TreeMo {
     ll cur = 0;
     TreeMo(int n) : n(n), st(n), en(n), vis(n, 0) {}
     void dfs(int u, int p, const vector<vector<int>>& g) {
-        st[u] = SZ(euler);
-        euler.push_back(u);
-        for (int v : g[u]) if (v != p) dfs(v, u, g);
-        en[u] = SZ(euler);
+        vector<int> par(n, -1);
+        par[u] = p;
+        dfs_iter(g, u,
+            [&](int x, int px) {
+                if (px != -1) par[x] = px;
+                st[x] = SZ(euler);
+                euler.push_back(x);
+            },
+            [&](int x, int y) { return y != par[x]; },
+            [&](int x, int) { en[x] = SZ(euler); });
     }
     struct Query { int l, r, idx; };
     void process(const vector<vector<int>>& g, const vector<int>& val, vector<Query>& qs) {
@@ -96,4 +104,86 @@ struct TreeMo {
     }
 };
 
+template <class D, class = void>
+struct dsu_tracks_parity : false_type {};
+template <class D>
+struct dsu_tracks_parity<D, void_t<decltype(declval<const D&>().bipartite())>> : true_type {};
+
+template <class D = RollbackDSU>
+struct DynamicConnectivity {
+    enum Kind { CONNECTED, COMPONENTS, BIPARTITE };
+    struct Query { Kind kind; int u, v; };
+    int n;
+    int T = 0;
+    vector<Query> qs;
+    vector<int> at;
+    map<pair<int,int>, vector<int>> open;
+    vector<tuple<int,int,int,int>> spans;
+    DynamicConnectivity(int n) : n(n) {}
+    static pair<int,int> key(int u, int v) { return {min(u, v), max(u, v)}; }
+    void add_edge(int u, int v) {
+        open[key(u, v)].push_back(T++);
+    }
+    bool remove_edge(int u, int v) {
+        auto it = open.find(key(u, v));
+        if (it == open.end() || it->second.empty()) return false;
+        spans.push_back({it->second.back(), T++, u, v});
+        it->second.pop_back();
+        return true;
+    }
+    int ask(Kind kind, int u = -1, int v = -1) {
+        if constexpr (!dsu_tracks_parity<D>::value) {
+            if (kind == BIPARTITE) throw invalid_argument("DynamicConnectivity: BIPARTITE needs a parity DSU");
+        }
+        at.push_back(T++);
+        qs.push_back({kind, u, v});
+        return SZ(qs) - 1;
+    }
+    int query_connected(int u, int v) { return ask(CONNECTED, u, v); }
+    int query_components() { return ask(COMPONENTS); }
+    int query_bipartite() { return ask(BIPARTITE); }
+    vector<int> solve() {
+        vector<int> ans(SZ(qs));
+        if (!T) return ans;
+        sz = 1;
+        while (sz < T) sz <<= 1;
+        tree.assign(2 * sz, {});
+        auto cover = [&](int l, int r, int u, int v) {
+            for (l += sz, r += sz; l < r; l >>= 1, r >>= 1) {
+                if (l & 1) tree[l++].push_back({u, v});
+                if (r & 1) tree[--r].push_back({u, v});
+            }
+        };
+        for (auto [l, r, u, v] : spans) cover(l, r, u, v);
+        for (auto& [k, starts] : open) for (int s : starts) cover(s, T, k.first, k.second);
+        qat.assign(T, -1);
+        REP(i, SZ(qs)) qat[at[i]] = i;
+        D dsu(n);
+        run(1, 0, sz, dsu, ans);
+        return ans;
+    }
+    int sz = 0;
+    vector<vector<pair<int,int>>> tree;
+    vector<int> qat;
+    int answer(const Query& q, D& dsu) {
+        if (q.kind == CONNECTED) return dsu.find(q.u) == dsu.find(q.v);
+        if (q.kind == COMPONENTS) return dsu.comps;
+        if constexpr (dsu_tracks_parity<D>::value) return dsu.bipartite();
+        return 0;
+    }
+    void run(int k, int lo, int hi, D& dsu, vector<int>& ans) {
+        if (lo >= T) return;
+        int snap = dsu.snapshot();
+        for (auto [u, v] : tree[k]) dsu.unite(u, v);
+        if (hi - lo == 1) {
+            if (qat[lo] >= 0) ans[qat[lo]] = answer(qs[qat[lo]], dsu);
+        } else {
+            int mid = (lo + hi) / 2;
+            run(2 * k, lo, mid, dsu, ans);
+            run(2 * k + 1, mid, hi, dsu, ans);
+        }
+        dsu.rollback(snap);
+    }
+};
+
 #endif
@@ -3,6 +3,7 @@
 
 #include "base.hpp"
 #include "math.hpp"
+#include "ds.hpp"
 
 inline vector<int> z_function(const string& s) {
     int n = SZ(s);
@@ -81,36 +82,106 @@ inline vector<int> manacher(const string& s) {
     return d;
 }
 
-inline vector<int> suffix_array(const string& s) {
-    string str = s;
-    str.push_back(char(0));
-    int n = SZ(str);
-    vector<int> sa(n), c(n);
-    iota(ALL(sa), 0);
-    sort(ALL(sa), [&](int a, int b){ return str[a] < str[b]; });
-    c[sa[0]] = 0;
-    FOR(i,1,n-1) c[sa[i]] = c[sa[i-1]] + (str[sa[i]] != str[sa[i-1]]);
-    for (int k = 0; (1 << k) < n; k++) {
-        int len = 1 << k;
-        vector<int> sa2(n), cnt(n);
-        for (int i = 0; i < n; i++) sa2[i] = (sa[i] - len + n) % n;
-        for (int x : c) cnt[x]++;
-        for (int i = 1; i < n; i++) cnt[i] += cnt[i-1];
-        for (int i = n - 1; i >= 0; i--) sa[--cnt[c[sa2[i]]]] = sa2[i];
-        vector<int> c2(n);
-        c2[sa[0]] = 0;
-        for (int i = 1; i < n; i++) {
-            pii cur = {c[sa[i]], c[(sa[i] + len) % n]};
-            pii prev = {c[sa[i-1]], c[(sa[i-1] + len) % n]};
-            c2[sa[i]] = c2[sa[i-1]] + (cur != prev);
+template <class I>
+struct SaisArr {
+    const I* p;
+    I operator()(I i) const { return p[i]; }
+};
+
+template <class I, class S>
+void sais_buckets(const S& chr, I n, I K, vector<I>& bkt, bool end) {
+    fill(ALL(bkt), 0);
+    for (I i = 0; i < n; i++) bkt[chr(i)]++;
+    I sum = 0;
+    for (I k = 0; k <= K; k++) {
+        sum += bkt[k];
+        bkt[k] = end ? sum : sum - bkt[k];
+    }
+}
+
+template <class I, class S>
+void sais_induce(const S& chr, const vector<bool>& t, I* sa, vector<I>& bkt, I n, I K) {
+    sais_buckets(chr, n, K, bkt, false);
+    for (I i = 0; i < n; i++) {
+        I j = sa[i] - 1;
+        if (j >= 0 && !t[j]) sa[bkt[chr(j)]++] = j;
+    }
+    sais_buckets(chr, n, K, bkt, true);
+    for (I i = n - 1; i >= 0; i--) {
+        I j = sa[i] - 1;
+        if (j >= 0 && t[j]) sa[--bkt[chr(j)]] = j;
+    }
+}
+
+template <class I, class S>
+void sais_core(const S& chr, I* sa, I n, I K) {
+    vector<bool> t(n);
+    t[n - 1] = 1;
+    for (I i = n - 2; i >= 0; i--) t[i] = chr(i) < chr(i + 1) || (chr(i) == chr(i + 1) && t[i + 1]);
+    auto lms = [&](I i) { return i > 0 && t[i] && !t[i - 1]; };
+    vector<I> bkt(K + 1);
+    sais_buckets(chr, n, K, bkt, true);
+    fill(sa, sa + n, I(-1));
+    for (I i = 1; i < n; i++) if (lms(i)) sa[--bkt[chr(i)]] = i;
+    sais_induce(chr, t, sa, bkt, n, K);
+    I n1 = 0;
+    for (I i = 0; i < n; i++) if (lms(sa[i])) sa[n1++] = sa[i];
+    fill(sa + n1, sa + n, I(-1));
+    I name = 0, prev = -1;
+    for (I i = 0; i < n1; i++) {
+        I pos = sa[i];
+        bool diff = false;
+        for (I d = 0; d < n; d++) {
+            if (prev == -1 || chr(pos + d) != chr(prev + d) || t[pos + d] != t[prev + d]) {
+                diff = true;
+                break;
+            }
+            if (d > 0 && (lms(pos + d) || lms(prev + d))) break;
         }
-        c.swap(c2);
-        if (c[sa.back()] == n - 1) break;
+        if (diff) {
+            name++;
+            prev = pos;
+        }
+        sa[n1 + pos / 2] = name - 1;
+    }
+    for (I i = n - 1, j = n - 1; i >= n1; i--) if (sa[i] >= 0) sa[j--] = sa[i];
+    I* s1 = sa + n - n1;
+    if (name < n1) sais_core(SaisArr<I>{s1}, sa, n1, name - 1);
+    else for (I i = 0; i < n1; i++) sa[s1[i]] = i;
+    for (I i = 1, j = 0; i < n; i++) if (lms(i)) s1[j++] = i;
+    for (I i = 0; i < n1; i++) sa[i] = s1[sa[i]];
+    fill(sa + n1, sa + n, I(-1));
+    sais_buckets(chr, n, K, bkt, true);
+    for (I i = n1 - 1; i >= 0; i--) {
+        I j = sa[i];
+        sa[i] = -1;
+        sa[--bkt[chr(j)]] = j;
     }
+    sais_induce(chr, t, sa, bkt, n, K);
+}
+
+template <class I = int>
+vector<I> suffix_array_sais(const string& s) {
+    I n = I(s.size()) + 1;
+    vector<I> sa(n);
+    sais_core([&](I i) { return i == n - 1 ? I(0) : I((unsigned char)s[i]) + 1; }, sa.data(), n, I(256));
+    sa.erase(sa.begin());
+    return sa;
+}
+
+template <class I = int>
+vector<I> suffix_array_sais(const vector<int>& s, int upper) {
+    I n = I(s.size()) + 1;
+    vector<I> sa(n);
+    sais_core([&](I i) { return i == n - 1 ? I(0) : I(s[i]) + 1; }, sa.data(), n, I(upper) + 1);
     sa.erase(sa.begin());
     return sa;
 }
 
+inline vector<int> suffix_array(const string& s) { return suffix_array_sais<int>(s); }
+inline vector<int> suffix_array(const vector<int>& s, int upper) { return suffix_array_sais<int>(s, upper); }
+inline vector<ll> suffix_array64(const string& s) { return suffix_array_sais<ll>(s); }
+
 inline vector<int> lcp_array(const string& s, const vector<int>& sa) {
     int n = SZ(s);
     vector<int> rank(n, 0), lcp(n - 1, 0);
@@ -126,4 +197,156 @@ inline vector<int> lcp_array(const string& s, const vector<int>& sa) {
     return lcp;
 }
 
+struct LCPIndex {
+    int n;
+    string s;
+    vector<int> sa, rank;
+    LinearRMQ<int> rmq;
+    LCPIndex(const string& str) : n(SZ(str)), s(str), sa(suffix_array(str)), rank(n) {
+        REP(i, n) rank[sa[i]] = i;
+        if (n) rmq = LinearRMQ<int>(lcp_array(s, sa));
+    }
+    const vector<int>& lcp() const { return rmq.a; }
+    int suffix_lcp(int i, int j) const {
+        if (i == j) return n - i;
+        int a = rank[i], b = rank[j];
+        if (a > b) swap(a, b);
+        return rmq.query(a, b - 1);
+    }
+    int common_prefix(int a, int alen, int b, int blen) const {
+        int m = min(alen, blen);
+        if (!m) return 0;
+        return min(m, suffix_lcp(a, b));
+    }
+    int compare(int a, int alen, int b, int blen) const {
+        int k = common_prefix(a, alen, b, blen);
+        if (k == min(alen, blen)) return alen < blen ? -1 : alen > blen;
+        return (unsigned char)s[a + k] < (unsigned char)s[b + k] ? -1 : 1;
+    }
+    template <bool Upper>
+    int bound(const string& p) const {
+        int m = SZ(p), lo = -1, hi = n, llo = 0, lhi = 0;
+        while (hi - lo > 1) {
+            int mid = (lo + hi) / 2, k = min(llo, lhi), x = sa[mid];
+            while (k < m && x + k < n && s[x + k] == p[k]) k++;
+            bool left = k == m ? Upper : x + k == n || (unsigned char)s[x + k] < (unsigned char)p[k];
+            if (left) lo = mid, llo = k;
+            else hi = mid, lhi = k;
+        }
+        return hi;
+    }
+    pair<int, int> range(const string& p) const { return {bound<false>(p), bound<true>(p)}; }
+    int count(const string& p) const {
+        auto [l, r] = range(p);
+        return r - l;
+    }
+    vector<int> locate(const string& p) const {
+        auto [l, r] = range(p);
+        vector<int> res(sa.begin() + l, sa.begin() + r);
+        sort(ALL(res));
+        return res;
+    }
+};
+
+struct FMIndex {
+    static constexpr uint32_t magic = 0x32494d46;
+    int n = 0, rate = 0;
+    array<int, 256> code;
+    vector<int> C, samples;
+    WaveletMatrix wm;
+    BitRank marked;
+    FMIndex() { code.fill(-1); }
+    FMIndex(const string& s, int rate = 32) : n(SZ(s)), rate(rate) {
+        code.fill(-1);
+        for (unsigned char ch : s) code[ch] = 0;
+        int sigma = 0;
+        REP(ch, 256) if (!code[ch]) code[ch] = ++sigma;
+        C.assign(sigma + 2, 0);
+        C[1] = 1;
+        for (unsigned char ch : s) C[code[ch] + 1]++;
+        REP(c, sigma + 1) C[c + 1] += C[c];
+        vector<int> sa = suffix_array(s), bwt(n + 1, 0);
+        if (n) bwt[0] = code[(unsigned char)s[n - 1]];
+        REP(i, n) if (sa[i]) bwt[i + 1] = code[(unsigned char)s[sa[i] - 1]];
+        int L = 1;
+        while ((1 << L) <= sigma) L++;
+        wm = WaveletMatrix(move(bwt), L);
+        if (!rate) return;
+        marked = BitRank(n + 1);
+        REP(i, n) if (sa[i] % rate == 0) {
+            marked.set(i + 1);
+            samples.push_back(sa[i]);
+        }
+        marked.build();
+    }
+    pair<int, int> range(const string& p) const {
+        if (p.empty()) return {1, n + 1};
+        int sp = 0, ep = n + 1;
+        FORD(k, SZ(p) - 1, 0) {
+            int c = code[(unsigned char)p[k]];
+            if (c < 0) return {0, 0};
+            sp = C[c] + wm.rank(c, sp);
+            ep = C[c] + wm.rank(c, ep);
+            if (sp >= ep) return {0, 0};
+        }
+        return {sp, ep};
+    }
+    int count(const string& p) const {
+        auto [l, r] = range(p);
+        return r - l;
+    }
+    vector<int> locate(const string& p) const {
+        if (!rate) throw logic_error("FMIndex: locate needs a sampled suffix array");
+        auto [l, r] = range(p);
+        vector<int> res;
+        res.reserve(r - l);
+        FOR(i, l, r - 1) {
+            int j = i, steps = 0;
+            while (!marked[j]) {
+                auto [c, k] = wm.access_rank(j);
+                j = C[c] + k;
+                if (++steps >= rate) throw runtime_error("FMIndex: corrupt sample marks");
+            }
+            res.push_back(samples[marked.rank1(j)] + steps);
+        }
+        sort(ALL(res));
+        return res;
+    }
+    size_t bytes() const { return sizeof(*this) + C.size() * sizeof(int) + samples.size() * sizeof(int) + wm.bytes() + marked.bytes(); }
+    void save(FILE* f) const {
+        write_raw(f, &magic, sizeof magic, 1);
+        write_raw(f, &n, sizeof n, 1);
+        write_raw(f, &rate, sizeof rate, 1);
+        write_raw(f, code.data(), sizeof(int), 256);
+        write_vec(f, C);
+        wm.save(f);
+        if (!rate) return;
+        write_vec(f, samples);
+        marked.save(f);
+    }
+    void load(FILE* f) {
+        uint32_t m;
+        read_raw(f, &m, sizeof m, 1);
+        if (m != magic) throw runtime_error("FMIndex: bad header");
+        read_raw(f, &n, sizeof n, 1);
+        read_raw(f, &rate, sizeof rate, 1);
+        read_raw(f, code.data(), sizeof(int), 256);
+        if (n < 0 || rate < 0) throw runtime_error("FMIndex: corrupt input");
+        read_vec(f, C);
+        int sigma = SZ(C) - 2;
+        if (sigma < 0 || sigma > 256 || C.back() != n + 1) throw runtime_error("FMIndex: corrupt input");
+        for (int c : code) if (c < -1 || c > sigma) throw runtime_error("FMIndex: corrupt input");
+        wm.load(f);
+        if (wm.n != n + 1 || (1 << wm.L) <= sigma || C[0]) throw runtime_error("FMIndex: corrupt input");
+        REP(c, sigma + 1) if (C[c + 1] - C[c] != wm.rank(c, n + 1)) throw runtime_error("FMIndex: corrupt input");
+        samples.clear();
+        marked = BitRank();
+        if (!rate) return;
+        read_vec(f, samples);
+        marked.load(f);
+        if (marked.n != n + 1 || SZ(samples) != marked.rank1(n + 1)) throw runtime_error("FMIndex: corrupt input");
+        for (int x : samples) if (x < 0 || x >= n) throw runtime_error("FMIndex: corrupt input");
+    }
+};
+
 #endif